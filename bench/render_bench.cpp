@@ -0,0 +1,278 @@
+// Offscreen benchmark of the plot render path.
+//
+// Renders `PlotView::render_plot` into a hidden GLFW window, with synthetic telemetry, and reports the CPU time of
+// every frame split into ImGui (new frame and draw lists finalization), plot items generation (`render_plot`) and GL
+// submission (`ImGui_ImplOpenGL3_RenderDrawData` up to `glFinish`).
+//
+// No GPU is needed: on Linux run it under Xvfb with Mesa's llvmpipe (`LIBGL_ALWAYS_SOFTWARE=1`), or with `--osmesa`
+// when GLFW was built with OSMesa support, which needs no display at all.
+
+#define GLFW_INCLUDE_NONE
+
+#include <GLFW/glfw3.h>
+#include <LP/geometryPrep.h>
+#include <LP/gpuPlot.h>
+#include <LP/plotView.h>
+#include <LP/shared.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <glad/glad.h>
+#include <imgui.h>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../src/bindings/imgui_impl_glfw.h"
+#include "../src/bindings/imgui_impl_opengl3.h"
+#include "../src/implot/implot.h"
+
+namespace {
+    struct BenchOptions {
+        int    channels = 8;
+        size_t samples  = 100000;
+        size_t append   = 0;
+        int    frames   = 300;
+        int    width    = 1600;
+        int    height   = 900;
+        bool   osmesa   = false;
+    };
+
+    struct StageTimes {
+        std::vector<double> imgui;
+        std::vector<double> items;
+        std::vector<double> gl;
+    };
+
+    void print_usage()
+    {
+        std::puts("usage: lp_render_bench [options]\n"
+                  "  --channels N  synthetic channels (default 8)\n"
+                  "  --samples N   samples per channel before the first frame (default 100000)\n"
+                  "  --append N    samples appended every frame, the plot follows them as while reading (default 0)\n"
+                  "  --frames N    measured frames (default 300)\n"
+                  "  --size WxH    framebuffer size (default 1600x900)\n"
+                  "  --osmesa      create the context with OSMesa on GLFW's null platform, without a display");
+    }
+
+    bool parse_options(int argc, char** argv, BenchOptions& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string arg   = argv[i];
+            const char*       value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+            if (arg == "--osmesa")
+            {
+                options.osmesa = true;
+                continue;
+            }
+
+            if (value == nullptr)
+                return false;
+
+            if (arg == "--channels")
+                options.channels = std::max(1, std::atoi(value));
+            else if (arg == "--samples")
+                options.samples = std::strtoull(value, nullptr, 10);
+            else if (arg == "--append")
+                options.append = std::strtoull(value, nullptr, 10);
+            else if (arg == "--frames")
+                options.frames = std::max(1, std::atoi(value));
+            else if (arg == "--size")
+            {
+                if (std::sscanf(value, "%dx%d", &options.width, &options.height) != 2)
+                    return false;
+            }
+            else
+                return false;
+
+            i++;
+        }
+
+        return true;
+    }
+
+    // noisy sines of different frequencies, one sample every millisecond
+    void append_samples(LP::Telemetry& tel, const int channels, const size_t count)
+    {
+        std::vector<double> frame(channels);
+        const size_t        first = tel.get_unix_timestamps()->size();
+
+        for (size_t i = first; i < first + count; i++)
+        {
+            for (int ch = 0; ch < channels; ch++)
+            {
+                frame[ch] = std::sin(i * 0.001 * (ch + 1)) * (ch + 1) + ((i * 2654435761u) % 1000) * 1e-4;
+            }
+
+            tel.push_frame(frame, 1.7e9 + i * 0.001, static_cast<double>(i));
+        }
+    }
+
+    void print_stage(const char* name, std::vector<double> times)
+    {
+        std::ranges::sort(times);
+
+        const double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+        std::printf("%-10s mean %8.3f ms   median %8.3f ms   p95 %8.3f ms   max %8.3f ms\n",
+                    name,
+                    mean,
+                    times[times.size() / 2],
+                    times[std::min(times.size() - 1, times.size() * 95 / 100)],
+                    times.back());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    if (options.osmesa)
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+
+    if (!glfwInit())
+    {
+        std::fputs("Failed to initialize GLFW\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    const char* glsl_version = "#version 330";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    if (options.osmesa)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    }
+
+    GLFWwindow* window = glfwCreateWindow(options.width, options.height, "lp_render_bench", nullptr, nullptr);
+
+    if (window == nullptr)
+    {
+        std::fputs("Failed to create the GLFW window\n", stderr);
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+    {
+        std::fputs("Failed to initialize GLAD\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+
+    ImGui_ImplGlfw_InitForOpenGL(window, false);
+    ImGui_ImplOpenGL3_Init(glsl_version);
+    LP::GpuPlot::init(glsl_version);
+
+    std::printf("renderer: %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    std::printf("%d channels, %zu samples, %zu appended per frame, %d frames at %dx%d\n\n",
+                options.channels,
+                options.samples,
+                options.append,
+                options.frames,
+                options.width,
+                options.height);
+
+    LP::Telemetry    tel;
+    LP::PlotView     plot_view;
+    LP::GeometryPrep prep(tel);
+
+    append_samples(tel, options.channels, options.samples);
+
+    const LP::app_state_t app_state = (options.append > 0) ? LP::READING : LP::IDLE;
+
+    StageTimes stages;
+
+    using clock = std::chrono::steady_clock;
+
+    const auto ms = [](const clock::time_point a, const clock::time_point b)
+    { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    // a few frames first, so that the fonts texture, the prepared geometry and the caches are in place
+    const int warmup = 10;
+
+    for (int frame = 0; frame < warmup + options.frames; frame++)
+    {
+        if (options.append > 0)
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+            append_samples(tel, options.channels, options.append);
+        }
+
+        const auto t0 = clock::now();
+
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        LP::GpuPlot::new_frame();
+        ImGui::NewFrame();
+
+        const auto t1 = clock::now();
+
+        plot_view.render_plot(tel, prep, app_state, 0, 0, options.width, options.height);
+
+        const auto t2 = clock::now();
+
+        ImGui::Render();
+
+        const auto t3 = clock::now();
+
+        glViewport(0, 0, options.width, options.height);
+        glClear(GL_COLOR_BUFFER_BIT);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glFinish();
+
+        const auto t4 = clock::now();
+
+        glfwSwapBuffers(window);
+
+        if (frame >= warmup)
+        {
+            stages.imgui.push_back(ms(t0, t1) + ms(t2, t3));
+            stages.items.push_back(ms(t1, t2));
+            stages.gl.push_back(ms(t3, t4));
+        }
+    }
+
+    print_stage("imgui", stages.imgui);
+    print_stage("plot items", stages.items);
+    print_stage("gl", stages.gl);
+
+    prep.stop();
+    plot_view.destroy();
+
+    LP::GpuPlot::destroy();
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    return EXIT_SUCCESS;
+}
@@ -9,6 +9,7 @@ class LambdaPlotterConan(ConanFile):
         self.requires("imgui/1.92.0")
         self.requires("glfw/3.4")
         self.requires("glad/0.1.36")
+        self.requires("zlib/1.3.1")
         self.requires("gtest/1.16.0")
 
     def layout(self):
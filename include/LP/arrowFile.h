@@ -0,0 +1,41 @@
+#ifndef __ARROW_FILE_H__
+#define __ARROW_FILE_H__
+
+#include "LP/telemetry.h"
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+// rows of a record batch
+#define ARROW_BATCH_ROWS 65536
+
+// alignment of the buffers in the record batches' bodies, the one recommended for SIMD reads
+#define ARROW_ALIGNMENT 64
+
+namespace LP {
+    // Writer of Arrow IPC files (the `.arrow` "Feather v2" format), which Python, Polars and most analysis tools map
+    // and read in place, without parsing. The flatbuffer metadata is encoded here, so that no Arrow library is needed.
+    //
+    // The columns are `time` (UTC timestamps in microseconds), `elapsed` (millis) and a double column per channel,
+    // holding its raw values: the channel's id, scale and offset are stored in the field's metadata. NaN values and the
+    // rows a channel doesn't reach are null.
+    class ArrowFile {
+        public:
+            /**
+             * @brief Save the whole capture to an Arrow IPC file. The data mutex is held only while a batch is
+             * copied, so that the reading thread can keep appending meanwhile.
+             *
+             * @param path
+             * @param tel
+             * @param progress if not null, set to the rows written so far
+             * @param cancel   if not null, the save stops as soon as it's set, leaving a partial file
+             * @return true if the file was written
+             */
+            static bool save(const std::string&       path,
+                             const Telemetry&         tel,
+                             std::atomic<size_t>*     progress = nullptr,
+                             const std::atomic<bool>* cancel   = nullptr);
+    };
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef __BYTE_LOG_H__
+#define __BYTE_LOG_H__
+
+#include "LP/mappedFile.h"
+#include "LP/telemetry.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BYTE_LOG_VERSION 1
+
+#define REPLAY_SPEEDS_SIZE 4
+
+namespace LP {
+    // replay speed of a raw byte capture, as a multiplier of the recorded pace. 0 replays as fast as possible.
+    typedef struct ReplaySpeed {
+        const char* label;
+        double      multiplier;
+    } ReplaySpeed;
+
+    inline constexpr std::array<ReplaySpeed, REPLAY_SPEEDS_SIZE> replay_speeds = {{{"1x", 1},
+                                                                                    {"10x", 10},
+                                                                                    {"100x", 100},
+                                                                                    {"Max", 0}}};
+
+    // `.lpraw` raw byte capture: a header (magic, version), then a record for every chunk returned by `Serial::read`:
+    // arrival unix time (double), size (uint32) and the bytes. All numbers are little endian.
+    //
+    // `ByteRecorder` writes the chunks from the reading thread, into a large stdio buffer.
+    class ByteRecorder {
+        private:
+            std::mutex        mtx;
+            std::FILE*        file   = nullptr;
+            std::atomic<bool> active = false;
+        public:
+            ByteRecorder() = default;
+            ~ByteRecorder() { stop(); }
+
+            ByteRecorder(const ByteRecorder&)            = delete;
+            ByteRecorder& operator=(const ByteRecorder&) = delete;
+
+            /**
+             * @brief Create the file and start recording
+             *
+             * @param path
+             * @return true if the file was created
+             */
+            bool start(const std::string& path);
+
+            /**
+             * @brief Flush and close the file
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Append a chunk of read bytes. Returns at once when not recording.
+             *
+             * @param bytes     bytes returned by `Serial::read`
+             * @param unix_time arrival time
+             */
+            void write(const std::vector<char>& bytes, double unix_time);
+
+            bool is_active() const { return active; }
+    };
+
+    // `ByteReplay` feeds a raw byte capture to `parse_serial` and `parse_frame` on a worker thread, as if it came from
+    // a live port, at the recorded pace times a multiplier or as fast as possible. Frames are stamped with the
+    // recorded arrival times, so a capture can be parsed again with another frame format.
+    class ByteReplay {
+        private:
+            std::thread worker;
+            MappedFile  file;
+
+            // offsets of the records in the file
+            std::vector<size_t> records;
+
+            std::atomic<bool>   running      = false;
+            std::atomic<bool>   cancelled    = false;
+            std::atomic<size_t> records_done = 0;
+            double              speed        = 1;
+
+            /**
+             * @brief Worker body: feed every record to the parser
+             *
+             */
+            void run(Telemetry& tel);
+        public:
+            ByteReplay() = default;
+            ~ByteReplay();
+
+            ByteReplay(const ByteReplay&)            = delete;
+            ByteReplay& operator=(const ByteReplay&) = delete;
+
+            /**
+             * @brief Open a `.lpraw` file, clear the telemetry and start replaying. Does nothing if a replay is
+             * already running.
+             *
+             * @param tel        telemetry to parse into, which must outlive the replay
+             * @param path
+             * @param multiplier replay speed, 0 for as fast as possible
+             * @return true if the file is valid and the replay started
+             */
+            bool start(Telemetry& tel, const std::string& path, double multiplier);
+
+            /**
+             * @brief Ask the running replay to stop
+             *
+             */
+            void cancel() { cancelled = true; }
+
+            /**
+             * @brief Join the worker once the replay has finished. Must be called regularly, e.g. every frame.
+             *
+             */
+            void poll();
+
+            /**
+             * @brief Cancel the running replay, if any, and join the worker
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Get the fraction of records replayed, from 0 to 1
+             *
+             */
+            float get_progress() const;
+
+            bool is_running() const { return running; }
+    };
+}
+
+#endif
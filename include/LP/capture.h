@@ -0,0 +1,125 @@
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// frames waiting to be written, newer frames are dropped when the writer falls behind
+#define CAPTURE_QUEUE_MAX 8
+
+namespace LP {
+    typedef enum CaptureMode {
+        CAPTURE_PNG_FRAMES,
+        CAPTURE_RAW_VIDEO
+    } CaptureMode;
+
+    // Captures a region of the rendered frames to disk. Every frame is read back asynchronously into one of two pixel
+    // buffer objects and collected on the next frame, when the GPU is done with it, so that the UI thread never waits
+    // on the GPU; encoding and writing run on a writer thread.
+    class Capture {
+        private:
+            typedef struct Frame {
+                std::vector<uint8_t> pixels;
+                int                  width;
+                int                  height;
+                size_t               index;
+            } Frame;
+
+            static bool         active;
+            static CaptureMode  mode;
+            static std::string  path;
+            static size_t       frame_count;
+            static size_t       dropped;
+
+            // region to capture, in window coordinates from the top left corner
+            static float region[4];
+
+            // raw video frames must all have the size of the first one
+            static int video_width;
+            static int video_height;
+
+            static unsigned int pbo[2];
+            static bool         pbo_pending[2];
+            static int          pbo_width[2];
+            static int          pbo_height[2];
+            static size_t       pbo_size[2];
+            static size_t       pbo_index;
+
+            static std::thread             writer;
+            static std::mutex              queue_mtx;
+            static std::condition_variable queue_cv;
+            static std::deque<Frame>       queue;
+            static bool                    writing;
+            static std::ofstream           video;
+
+            /**
+             * @brief Map a pixel buffer whose read back has completed, and queue its frame for the writer
+             *
+             * @param slot pixel buffer index
+             */
+            static void collect(size_t slot);
+
+            /**
+             * @brief Writer thread loop: write the queued frames until the capture is stopped and the queue is empty
+             *
+             */
+            static void write_loop();
+
+            /**
+             * @brief Encode a frame as an 8 bit RGBA PNG file
+             *
+             * @param file_path
+             * @param frame     top to bottom rows
+             * @return true if the file was written
+             */
+            static bool write_png(const std::string& file_path, const Frame& frame);
+        public:
+            /**
+             * @brief Start capturing the region to `file_path`: numbered PNG files next to it, or a single stream
+             * of raw RGBA frames
+             *
+             * @param file_path
+             * @param capture_mode
+             * @return true if the capture started
+             */
+            static bool start(const std::string& file_path, CaptureMode capture_mode);
+
+            /**
+             * @brief Collect the pending frames, write them and stop the capture
+             *
+             */
+            static void stop();
+
+            /**
+             * @brief Set the captured region, in window coordinates
+             *
+             */
+            static void set_region(float x, float y, float width, float height);
+
+            /**
+             * @brief Read back the region of the frame just rendered. Must be called after the draw data is rendered
+             * and before the buffers are swapped.
+             *
+             */
+            static void capture();
+
+            /**
+             * @brief Stop the capture and delete the pixel buffers
+             *
+             */
+            static void destroy();
+
+            static bool   is_active() { return active; }
+            static size_t get_frame_count() { return frame_count; }
+            static size_t get_dropped() { return dropped; }
+    };
+}
+
+#endif
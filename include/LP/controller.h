@@ -1,7 +1,13 @@
 #ifndef __CONTROLLER_H__
 #define __CONTROLLER_H__
 
+#include "byteLog.h"
+#include "capture.h"
+#include "exportJob.h"
+#include "geometryPrep.h"
+#include "importJob.h"
 #include "plotView.h"
+#include "recorder.h"
 #include "telemetry.h"
 #include "toolbar.h"
 #include <mutex>
@@ -16,6 +22,22 @@ namespace LP {
             static ToolBar   toolbar;
             static Telemetry tel;
             static PlotView  plot_view;
+
+            // prepares the plotted points on its own thread, from `tel`
+            static GeometryPrep geometry_prep;
+
+            // saves the plot view to a csv file in the background
+            static ExportJob export_job;
+
+            // loads a saved capture in the background
+            static ImportJob import_job;
+
+            // appends the received data to a file while reading
+            static Recorder recorder;
+
+            // records the bytes read from the port, and replays them
+            static ByteRecorder byte_recorder;
+            static ByteReplay   byte_replay;
             
             // application state variable (either READING or IDLE)
             static app_state_t prev_app_state;
@@ -30,10 +52,48 @@ namespace LP {
             static void start_serial_reading(const std::string& port, size_t baud);
 
             /**
-             * @brief Wrapper method for saving the plot view to a csv file 
+             * @brief Build the file name proposed by a save dialog: `<prefix>[_<device>]_<datetime><suffix>`, without
+             * the ':' of the datetime
+             * 
+             * @param prefix
+             * @param suffix      extension, with anything to add before it
+             * @param with_device if true, the name of the last opened port is included
+             */
+            static std::string default_file_name(const std::string& prefix,
+                                                 const std::string& suffix,
+                                                 bool               with_device);
+
+            /**
+             * @brief Wrapper method for saving the plot view to a csv file, or the whole capture to a lpcap or Arrow
+             * file, in the background
              * 
              */
             static void save_file();
+
+            /**
+             * @brief Wrapper method for opening a saved capture or a CSV file, or replaying a raw byte capture
+             * 
+             */
+            static void open_file();
+
+            /**
+             * @brief Ask where to record the received data, and start recording
+             * 
+             */
+            static void start_recording();
+
+            /**
+             * @brief Ask where to record the bytes read from the port, and start recording
+             * 
+             */
+            static void start_raw_recording();
+
+            /**
+             * @brief Ask where to save the capture of the plot, and start it
+             * 
+             * @param mode PNG frames or raw video
+             */
+            static void start_capture(CaptureMode mode);
         public:
             /**
              * @brief Method responsible to handle the application's state and all his functions
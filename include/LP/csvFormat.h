@@ -0,0 +1,63 @@
+#ifndef __CSV_FORMAT_H__
+#define __CSV_FORMAT_H__
+
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <ctime>
+#include <string>
+
+// size of the blocks written to the file at once
+#define CSV_WRITE_BLOCK (1 << 20)
+
+// expected size of a formatted field, to size the blocks formatted by each thread
+#define CSV_FIELD_BYTES 12
+
+// blocks formatted ahead of the file, per formatting thread
+#define CSV_FORMAT_AHEAD 2
+
+namespace LP {
+    // Formats CSV rows in the `dump_data` layout (';' separators, ',' decimals) by appending to a reusable buffer.
+    // Numbers are written with `std::to_chars`, and datetime strings are cached for the current second, since
+    // consecutive rows almost always share it.
+    class CsvFormatter {
+        private:
+            time_t      cached_second = -1;
+            std::string cached_datetime;
+        public:
+            /**
+             * @brief Append the header: "times" followed by the channels' names
+             *
+             * @param out      destination buffer
+             * @param snapshot
+             */
+            static void append_header(std::string& out, const Snapshot& snapshot);
+
+            /**
+             * @brief Append a value with 6 decimals and a ',' decimal separator, or nothing if it is NaN
+             *
+             * @param out   destination buffer
+             * @param value
+             */
+            static void append_value(std::string& out, double value);
+
+            /**
+             * @brief Append a timestamp, as a datetime string or as rounded elapsed millis
+             *
+             * @param out  destination buffer
+             * @param time
+             * @param ts   time format (DATETIME or ELAPSED)
+             */
+            void append_time(std::string& out, double time, PlotTimeStyle ts);
+
+            /**
+             * @brief Append a row of the snapshot, with its line end
+             *
+             * @param out      destination buffer
+             * @param snapshot
+             * @param row      row index
+             */
+            void append_row(std::string& out, const Snapshot& snapshot, size_t row);
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __CSV_IMPORT_H__
+#define __CSV_IMPORT_H__
+
+#include "LP/mappedFile.h"
+#include "LP/telemetry.h"
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// smallest block parsed by a thread, smaller files are parsed by fewer threads
+#define CSV_IMPORT_MIN_BLOCK (1 << 20)
+
+// rows parsed between two progress updates and cancel checks
+#define CSV_IMPORT_CHECK_ROWS 16384
+
+namespace LP {
+    // Loads CSV files for offline viewing: the exported dumps (';' separators, ',' decimals) as well as plain ',' and
+    // '.' files. The first column holds the times, as datetimes or elapsed millis, the others the channels' values.
+    //
+    // The file is memory mapped, or inflated in memory if it's gzip compressed, and split at row boundaries into a
+    // block per core. A first pass counts the rows of
+    // every block, so that the columns can be allocated at their final size and every block knows its first row; a
+    // second pass parses the blocks in parallel, straight into the columns.
+    class CsvImport {
+        private:
+            typedef struct Dialect {
+                char sep;
+                char decimal;
+                bool header;
+                bool datetime;
+            } Dialect;
+
+            // a mapped file, or the text of a gzip one, and the row boundaries of its blocks
+            typedef struct Source {
+                MappedFile               file;
+                std::string              inflated;
+                std::string_view         text;
+                bool                     compressed;
+                Dialect                  dialect;
+                std::vector<const char*> bounds;
+            } Source;
+
+            /**
+             * @brief Parse a time field
+             *
+             * @param field
+             * @param datetime true for "%Y-%m-%d_%H:%M:%S" datetimes, false for numbers
+             * @return the unix timestamp or the elapsed millis, NaN if the field isn't valid
+             */
+            static double parse_time(std::string_view field, bool datetime);
+
+            /**
+             * @brief Parse a value field
+             *
+             * @param field
+             * @param decimal decimal separator
+             * @return the value, NaN if the field is empty or isn't valid
+             */
+            static double parse_value(std::string_view field, char decimal);
+
+            /**
+             * @brief Guess the separators, whether the file has a header and the time format from its first lines
+             *
+             * @param first_line
+             * @param second_line the first data row when the first line is a header
+             */
+            static Dialect detect(std::string_view first_line, std::string_view second_line);
+        public:
+            /**
+             * @brief Load a CSV file, replacing the telemetry's data. Nothing is replaced if the file can't be read or
+             * the load is cancelled.
+             *
+             * @param path
+             * @param tel
+             * @param progress if not null, advanced by the bytes parsed, up to the file size
+             * @param cancel   if not null, the load stops as soon as it's set
+             * @return true if the file was loaded
+             */
+            static bool load(const std::string&       path,
+                             Telemetry&               tel,
+                             std::atomic<size_t>*     progress = nullptr,
+                             const std::atomic<bool>* cancel   = nullptr);
+
+            /**
+             * @brief Load the files of a set, e.g. of a rotated recording, one after the other as a single capture.
+             * The first file sets the columns.
+             *
+             * @param paths    files in time order
+             * @param tel
+             * @param progress if not null, advanced by the bytes parsed, up to the files' total size
+             * @param cancel   if not null, the load stops as soon as it's set
+             * @return true if every file was loaded
+             */
+            static bool load(const std::vector<std::string>& paths,
+                             Telemetry&                      tel,
+                             std::atomic<size_t>*            progress = nullptr,
+                             const std::atomic<bool>*        cancel   = nullptr);
+    };
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef __EXPORT_JOB_H__
+#define __EXPORT_JOB_H__
+
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace LP {
+    struct ChannelStyle;
+
+    typedef enum ExportFormat {
+        EXPORT_CSV,
+        EXPORT_LPCAP,
+        EXPORT_ARROW
+    } ExportFormat;
+
+    typedef enum ExportState {
+        EXPORT_IDLE,
+        EXPORT_RUNNING,
+        EXPORT_DONE,
+        EXPORT_CANCELLED,
+        EXPORT_FAILED
+    } ExportState;
+
+    // `ExportJob` saves the telemetry on a worker thread: a time window to a CSV file, or the whole capture to a
+    // `.lpcap` or an Arrow file. The worker copies the data, holding the data mutex only for the copy, and writes it
+    // afterwards, so that neither the UI nor the reading thread wait for the disk.
+    class ExportJob {
+        private:
+            std::thread worker;
+
+            std::atomic<ExportState> state       = EXPORT_IDLE;
+            std::atomic<bool>        cancelled   = false;
+            std::atomic<size_t>      rows_done   = 0;
+            std::atomic<size_t>      rows_total  = 0;
+            std::string              path;
+            ExportFormat             format      = EXPORT_CSV;
+
+            /**
+             * @brief Worker body: copy the data and write it
+             *
+             */
+            void run(const Telemetry&                      tel,
+                     Limits                                limits,
+                     std::unordered_map<int, ChannelStyle> ch_styles,
+                     PlotTimeStyle                         ts);
+        public:
+            ExportJob() = default;
+            ~ExportJob();
+
+            ExportJob(const ExportJob&)            = delete;
+            ExportJob& operator=(const ExportJob&) = delete;
+
+            /**
+             * @brief Start exporting, unless an export is already running
+             *
+             * @param tel         telemetry to export, which must outlive the job
+             * @param file_path   path to the file
+             * @param file_format CSV for the plot view, LPCAP or ARROW for the whole capture
+             * @param limits      plot limits where the CSV data will be taken
+             * @param ch_styles   plot channels style
+             * @param ts          time format (DATETIME or ELAPSED) of the CSV file
+             * @return true if the export started
+             */
+            bool start(const Telemetry&                      tel,
+                       const std::string&                    file_path,
+                       ExportFormat                          file_format,
+                       Limits                                limits,
+                       std::unordered_map<int, ChannelStyle> ch_styles,
+                       PlotTimeStyle                         ts);
+
+            /**
+             * @brief Ask the running export to stop. The partial file is removed.
+             *
+             */
+            void cancel() { cancelled = true; }
+
+            /**
+             * @brief Join the worker once the export has finished. Must be called regularly, e.g. every frame.
+             *
+             */
+            void poll();
+
+            /**
+             * @brief Cancel the running export, if any, and join the worker
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Get the fraction of rows written, from 0 to 1
+             *
+             */
+            float get_progress() const;
+
+            bool        is_running() const { return state == EXPORT_RUNNING; }
+            ExportState get_state() const { return state; }
+    };
+}
+
+#endif
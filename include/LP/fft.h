@@ -0,0 +1,31 @@
+#ifndef __FFT_H__
+#define __FFT_H__
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace LP {
+    // Radix-2 fast Fourier transform, used for the spectrogram
+    class FFT {
+        public:
+            /**
+             * @brief In place forward transform
+             *
+             * @param data samples, whose size must be a power of two
+             */
+            static void transform(std::vector<std::complex<double>>& data);
+
+            /**
+             * @brief Power spectrum of a Hann windowed block of samples, in dB. NaN samples count as zeros.
+             *
+             * @param samples block of `n` samples, `n` must be a power of two
+             * @param n       block size
+             * @param out     `n / 2` bins, from DC up to just below the Nyquist frequency
+             * @param work    scratch buffer, resized to `n`
+             */
+            static void power_db(const double* samples, size_t n, float* out, std::vector<std::complex<double>>& work);
+    };
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef __GEOMETRY_PREP_H__
+#define __GEOMETRY_PREP_H__
+
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define PREP_MARGIN 0.5
+
+namespace LP {
+    // channel to prepare, with the transform applied to its values
+    typedef struct PrepChannel {
+        int    ch_id;
+        double scale;
+        double offset;
+
+        bool operator==(const PrepChannel&) const = default;
+    } PrepChannel;
+
+    // view the geometry is prepared for
+    typedef struct PrepRequest {
+        double        x_min      = 0;
+        double        x_max      = 1;
+        int           width      = 0;
+        PlotTimeStyle time_style = DATETIME;
+
+        std::vector<PrepChannel> channels;
+
+        bool operator==(const PrepRequest&) const = default;
+    } PrepRequest;
+
+    // screen-ready points of a channel: scaled values, decimated to the plot width
+    typedef struct PreparedChannel {
+        std::vector<double> xs;
+        std::vector<double> ys;
+    } PreparedChannel;
+
+    // geometry of every requested channel, together with the view it was prepared for
+    typedef struct PreparedFrame {
+        PrepRequest request;
+        size_t      samples = 0;
+
+        std::unordered_map<int, PreparedChannel> channels;
+
+        /**
+         * @brief Check if the prepared points cover a view, margin included
+         *
+         * @param x_min
+         * @param x_max
+         * @param ts    time style of the view
+         */
+        bool covers(double x_min, double x_max, PlotTimeStyle ts) const;
+    } PreparedFrame;
+
+    // `GeometryPrep` prepares the plotted points of the next frame on a worker thread: the visible range of every shown
+    // channel, plus a margin on both sides, is scaled and decimated to a min/max pair per pixel column. The UI thread
+    // posts the current view every frame and only submits the last prepared buffers.
+    class GeometryPrep {
+        private:
+            Telemetry& tel;
+
+            std::thread             worker;
+            std::mutex              request_mtx;
+            std::condition_variable request_cv;
+            PrepRequest             request;
+            size_t                  request_samples = 0;
+            bool                    pending         = false;
+            bool                    running         = false;
+
+            // samples of a channel copied out of the telemetry, so that they're prepared without holding its lock
+            typedef struct PrepSlice {
+                int                 ch_id;
+                double              scale;
+                double              offset;
+                std::vector<double> times;
+                std::vector<double> values;
+            } PrepSlice;
+
+            // reused by the worker, a slice per requested channel
+            std::vector<PrepSlice> slices;
+
+            // the buffer being filled by the worker, and the one read by the UI
+            PreparedFrame back;
+            PreparedFrame front;
+            std::mutex    front_mtx;
+
+            /**
+             * @brief Worker loop: wait for a new request and prepare it
+             *
+             */
+            void run();
+
+            /**
+             * @brief Fill the back buffer for a request. The telemetry data is only locked while the visible samples
+             * are copied.
+             *
+             * @param req
+             */
+            void prepare(const PrepRequest& req);
+        public:
+            explicit GeometryPrep(Telemetry& tel) : tel(tel) {}
+            ~GeometryPrep();
+
+            GeometryPrep(const GeometryPrep&)            = delete;
+            GeometryPrep& operator=(const GeometryPrep&) = delete;
+
+            /**
+             * @brief Post the current view. The worker is started on the first request, and only wakes up when the
+             * view or the number of samples differ from the last prepared ones.
+             *
+             * @param req
+             * @param samples current number of samples
+             */
+            void post(const PrepRequest& req, size_t samples);
+
+            /**
+             * @brief Stop and join the worker
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Decimate the samples in [first, last) to a min/max pair per column of `dx` width, in time order.
+             * Columns without valid values are kept as a NAN gap.
+             *
+             * @param times  timestamps
+             * @param values raw channel values
+             * @param first  index of the first sample
+             * @param last   index past the last sample
+             * @param scale  channel scale
+             * @param offset channel offset
+             * @param dx     column width, in time units
+             * @param out    destination, cleared first
+             */
+            static void decimate(const std::vector<double>& times,
+                                 const std::vector<double>& values,
+                                 size_t                     first,
+                                 size_t                     last,
+                                 double                     scale,
+                                 double                     offset,
+                                 double                     dx,
+                                 PreparedChannel&           out);
+
+            std::mutex&          get_front_mtx() { return front_mtx; }
+            const PreparedFrame& get_front() const { return front; }
+    };
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef __GPU_PLOT_H__
+#define __GPU_PLOT_H__
+
+#include <cstddef>
+#include <imgui.h>
+#include <vector>
+
+namespace LP {
+    // Plot items drawn directly with OpenGL from an ImDrawList callback, instead of being tessellated by ImPlot on the CPU.
+    // Every plot function falls back to its ImPlot counterpart when the GPU path is not available.
+    class GpuPlot {
+        private:
+            // per-item geometry, uploaded and drawn by the render callbacks
+            struct Batch;
+
+            static std::vector<Batch> batches;
+            static size_t             batch_count;
+
+            static bool         available;
+            static bool         instancing;
+            static unsigned int line_program;
+            static unsigned int marker_program;
+            static unsigned int vao;
+            static unsigned int marker_vao;
+            static unsigned int vbo;
+            static unsigned int mesh_vbo;
+
+            static int line_loc_proj;
+            static int line_loc_transform;
+            static int line_loc_color;
+
+            static int marker_loc_proj;
+            static int marker_loc_transform;
+            static int marker_loc_color;
+            static int marker_loc_size;
+
+            /**
+             * @brief Get an empty batch for the current frame, reusing the memory of the previous frames
+             */
+            static Batch& next_batch();
+
+            /**
+             * @brief Compile and link a shader program
+             *
+             * @param vertex_src   vertex shader source, without the version line
+             * @param fragment_src fragment shader source, without the version line
+             * @return the program, or 0 on failure
+             */
+            static unsigned int create_program(const char* vertex_src, const char* fragment_src);
+
+            /**
+             * @brief Set the scissor rect and the projection matrix for a draw command
+             *
+             * @param cmd       the callback draw command
+             * @param loc_proj  projection matrix uniform location of the bound program
+             */
+            static void setup_render_state(const ImDrawCmd* cmd, int loc_proj);
+
+            /**
+             * @brief Upload the markers mesh and set up the instanced vertex array
+             *
+             */
+            static void init_markers();
+
+            static void render_line(const ImDrawList* draw_list, const ImDrawCmd* cmd);
+            static void render_markers(const ImDrawList* draw_list, const ImDrawCmd* cmd);
+        public:
+            /**
+             * @brief Create the GL objects. Must be called after the OpenGL context and the ImGui backend are initialized.
+             *
+             * @param glsl_version the same GLSL version string given to the ImGui OpenGL backend
+             * @return true if the GPU path is available
+             */
+            static bool init(const char* glsl_version);
+
+            /**
+             * @brief Recycle the batches of the previous frame. Must be called once per frame, before plotting.
+             *
+             */
+            static void new_frame();
+
+            /**
+             * @brief Delete the GL objects
+             *
+             */
+            static void destroy();
+
+            static bool is_available() { return available; }
+
+            /**
+             * @brief Plot a 1px non-antialiased line, uploading one vertex per visible point and drawing it as a
+             * GL_LINE_STRIP. `xs` must be sorted, as the channels' timestamps are. Same signature as `ImPlot::PlotLine`.
+             *
+             */
+            static void plot_line(const char* label, const double* xs, const double* ys, int count, int flags, int offset, int stride);
+
+            /**
+             * @brief Plot markers with GPU instancing: a single marker mesh drawn once per visible point, from a
+             * per-instance position buffer. `xs` must be sorted. Same signature as `ImPlot::PlotScatter`.
+             *
+             */
+            static void plot_scatter(const char* label, const double* xs, const double* ys, int count, int flags, int offset, int stride);
+    };
+}
+
+#endif
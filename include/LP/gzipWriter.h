@@ -0,0 +1,94 @@
+#ifndef __GZIP_WRITER_H__
+#define __GZIP_WRITER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// blocks waiting to be compressed; `write` waits when the compressor is this far behind
+#define GZIP_QUEUE_BLOCKS 4
+
+// size of the compressed chunks written to the file
+#define GZIP_OUT_CHUNK (1 << 18)
+
+namespace LP {
+    // `GzipWriter` writes a gzip file from blocks of text. Compression runs on a worker thread, so that the caller
+    // formats the next block while the previous one is compressed and written; the emptied blocks are handed back to
+    // the caller, so that their memory is reused.
+    class GzipWriter {
+        private:
+            typedef struct Block {
+                std::string data;
+                bool        flush;
+                bool        sync;
+            } Block;
+
+            std::thread             worker;
+            std::mutex              mtx;
+            std::condition_variable cv;
+            std::atomic<bool>       failed = false;
+
+            // guarded by `mtx`
+            std::deque<Block>        queue;
+            std::vector<std::string> spares;
+            bool                     closing = false;
+
+            // used by the worker while open
+            std::FILE* file = nullptr;
+
+            /**
+             * @brief Worker loop: compress and write the queued blocks until closed, then end the gzip stream
+             *
+             */
+            void run(int level);
+        public:
+            GzipWriter() = default;
+            ~GzipWriter();
+
+            GzipWriter(const GzipWriter&)            = delete;
+            GzipWriter& operator=(const GzipWriter&) = delete;
+
+            /**
+             * @brief Create the file and start the compressor
+             *
+             * @param path
+             * @param level zlib compression level, from 1 (fastest) to 9 (smallest), -1 for zlib's default
+             * @return true if the file was created
+             */
+            bool open(const std::string& path, int level = -1);
+
+            /**
+             * @brief Queue a block for compression, waiting if the compressor is GZIP_QUEUE_BLOCKS behind. `block` is
+             * swapped with an emptied one.
+             *
+             * @param block
+             * @param flush if true, everything written so far can be decompressed once the block is written
+             * @param sync  if true, the file is also flushed to the disk with fsync
+             * @return false if the file couldn't be written
+             */
+            bool write(std::string& block, bool flush = false, bool sync = false);
+
+            /**
+             * @brief Compress the queued blocks, end the gzip stream and close the file
+             *
+             * @return false if the file couldn't be written
+             */
+            bool close();
+
+            bool is_open() const { return file != nullptr; }
+
+            /**
+             * @brief Check if a path names a gzip file, by its `.gz` extension
+             *
+             */
+            static bool is_gzip_path(const std::string& path);
+    };
+}
+
+#endif
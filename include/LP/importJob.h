@@ -0,0 +1,113 @@
+#ifndef __IMPORT_JOB_H__
+#define __IMPORT_JOB_H__
+
+#include "LP/lpcap.h"
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace LP {
+    // `ImportJob` opens a saved capture for offline viewing. The file's index is read on the calling thread, so that
+    // the plot can be framed at once; the values are then loaded into the telemetry on a worker thread, a chunk at a
+    // time, and show up as they arrive. CSV files have no index: they're parsed on the worker and replace the data
+    // at once, when the whole file is parsed. The files of a rotated recording are loaded the same way, picked from
+    // their `.lpidx` index by time.
+    class ImportJob {
+        private:
+            std::thread worker;
+
+            std::atomic<bool>   running    = false;
+            std::atomic<bool>   cancelled  = false;
+            std::atomic<bool>   completed  = false;
+            std::atomic<size_t> work_done  = 0;
+            size_t              work_total = 0;
+
+            LpCapFile                capture;
+            std::vector<std::string> csv_paths;
+
+            // time range and values' extents of the opened file, for both time styles
+            Limits overview_unix    = {0, 1, 0, 1};
+            Limits overview_elapsed = {0, 1, 0, 1};
+
+            /**
+             * @brief Worker body: load the chunks
+             *
+             */
+            void run(Telemetry& tel);
+
+            /**
+             * @brief Worker body: parse the CSV files, and get the overview of the loaded data
+             *
+             */
+            void run_csv(Telemetry& tel);
+        public:
+            ImportJob() = default;
+            ~ImportJob();
+
+            ImportJob(const ImportJob&)            = delete;
+            ImportJob& operator=(const ImportJob&) = delete;
+
+            /**
+             * @brief Open a `.lpcap` file, replace the telemetry's data and frame format with its own and start
+             * loading its values, or start parsing a `.csv` file or the files of a `.lpidx` index. Does nothing if a
+             * load is already running.
+             *
+             * @param tel  telemetry to load into, which must outlive the job
+             * @param path
+             * @param from for indexes, load only the files with rows from this time...
+             * @param to   ...to this time, in the index's time style
+             * @return true if the file is valid and the load started
+             */
+            bool start(Telemetry&         tel,
+                       const std::string& path,
+                       double             from = -std::numeric_limits<double>::infinity(),
+                       double             to   = std::numeric_limits<double>::infinity());
+
+            /**
+             * @brief Ask the running load to stop. The rows loaded so far are kept.
+             *
+             */
+            void cancel() { cancelled = true; }
+
+            /**
+             * @brief Join the worker once the load has finished. Must be called regularly, e.g. every frame.
+             *
+             */
+            void poll();
+
+            /**
+             * @brief Cancel the running load, if any, and join the worker
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Get the fraction of rows, or CSV bytes, loaded, from 0 to 1
+             *
+             */
+            float get_progress() const;
+
+            /**
+             * @brief Get the time range and the values' extents of the opened file. Known as soon as a capture is
+             * opened, and once a CSV file is completely parsed.
+             *
+             * @param ts time format (DATETIME or ELAPSED)
+             */
+            Limits get_overview(PlotTimeStyle ts) const { return (ts == DATETIME) ? overview_unix : overview_elapsed; }
+
+            /**
+             * @brief Check whether a CSV load has completed since the last call, so that the plot can be framed
+             *
+             */
+            bool take_completed() { return completed.exchange(false); }
+
+            bool is_running() const { return running; }
+    };
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef __LPCAP_H__
+#define __LPCAP_H__
+
+#include "LP/mappedFile.h"
+#include "LP/rangeIndex.h"
+#include "LP/telemetry.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define LPCAP_VERSION    1
+#define LPCAP_CHUNK_ROWS 65536
+
+namespace LP {
+    // channel metadata stored in the header
+    typedef struct LpCapChannel {
+        int         id;
+        std::string name;
+        double      scale;
+        double      offset;
+    } LpCapChannel;
+
+    // chunk index entry, with the overview summary of the chunk
+    typedef struct LpCapChunk {
+        uint64_t offset;
+        uint64_t rows;
+        double   unix_first;
+        double   unix_last;
+        double   elapsed_first;
+        double   elapsed_last;
+
+        // raw values' extents of every channel, in header order
+        std::vector<Extents> extents;
+    } LpCapChunk;
+
+    // `.lpcap` native capture file. All numbers are little endian.
+    //
+    //   header   magic, version, frame format, channels (id, name, scale, offset)
+    //   chunks   up to LPCAP_CHUNK_ROWS rows, 8 bytes aligned: unix times, elapsed times, then the raw values of every
+    //            channel, each one a contiguous array of doubles
+    //   index    chunk count, then offset, rows, time ranges and channels' extents of every chunk
+    //   trailer  index offset, magic
+    //
+    // Saving copies the storage a chunk at a time; opening maps the file and reads only the header and the index, so
+    // the time range and the extents are known before any value is read, and chunks are then loaded straight from the
+    // mapping.
+    class LpCapFile {
+        private:
+            MappedFile file;
+
+            FrameFormat               frame_format;
+            std::vector<LpCapChannel> channels;
+            std::vector<LpCapChunk>   chunks;
+        public:
+            /**
+             * @brief Save the whole telemetry. The data mutex is held only while a chunk is copied.
+             *
+             * @param path
+             * @param tel
+             * @param progress if set, updated with the number of rows written
+             * @param cancel   if set, the save stops as soon as it becomes true
+             * @return true if the whole capture was written
+             */
+            static bool save(const std::string&       path,
+                             const Telemetry&         tel,
+                             std::atomic<size_t>*     progress = nullptr,
+                             const std::atomic<bool>* cancel   = nullptr);
+
+            /**
+             * @brief Map a file and read its header and index
+             *
+             * @param path
+             * @return true if the file is a valid capture
+             */
+            bool open(const std::string& path);
+
+            /**
+             * @brief Append a chunk to the telemetry. The caller must hold the data mutex.
+             *
+             * @param chunk chunk index
+             * @param tel
+             */
+            void load_chunk(size_t chunk, Telemetry& tel) const;
+
+            /**
+             * @brief Unmap the file. The header and the index are kept.
+             *
+             */
+            void close() { file.close(); }
+
+            /**
+             * @brief Get the time range and the values' extents of the whole capture, from the index
+             *
+             * @param ts time format (DATETIME or ELAPSED)
+             * @return the limits, X from the first to the last timestamp and Y over every scaled channel
+             */
+            Limits get_overview(PlotTimeStyle ts) const;
+
+            /**
+             * @brief Get the total number of rows
+             *
+             */
+            size_t get_rows() const;
+
+            const FrameFormat&               get_frame_format() const { return frame_format; }
+            const std::vector<LpCapChannel>& get_channels() const { return channels; }
+            const std::vector<LpCapChunk>&   get_chunks() const { return chunks; }
+    };
+}
+
+#endif
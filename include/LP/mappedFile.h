@@ -0,0 +1,44 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstddef>
+#include <string>
+
+namespace LP {
+    // Read only memory mapping of a whole file
+    class MappedFile {
+        private:
+            const char* data = nullptr;
+            size_t      size = 0;
+
+#ifdef _WIN32
+            void* file_handle    = nullptr;
+            void* mapping_handle = nullptr;
+#endif
+        public:
+            MappedFile() = default;
+            ~MappedFile() { close(); }
+
+            MappedFile(const MappedFile&)            = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /**
+             * @brief Map the file, closing the previous mapping first
+             *
+             * @param path
+             * @return true if the file was mapped. Empty files can't be mapped.
+             */
+            bool open(const std::string& path);
+
+            /**
+             * @brief Unmap the file
+             *
+             */
+            void close();
+
+            const char* get_data() const { return data; }
+            size_t      get_size() const { return size; }
+    };
+}
+
+#endif
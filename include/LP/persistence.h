@@ -0,0 +1,114 @@
+#ifndef __PERSISTENCE_H__
+#define __PERSISTENCE_H__
+
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <cstddef>
+#include <cstdint>
+#include <imgui.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#define PERSISTENCE_WIDTH  512
+#define PERSISTENCE_HEIGHT 256
+
+// hits on a pixel that light it up to ~63% of the channel color
+#define PERSISTENCE_GAIN 4.0f
+
+namespace LP {
+    // `Persistence` accumulates the sweeps of the shown channels into density images, like the phosphor of an analog
+    // oscilloscope. Every new sample is drawn once into the image of its channel, and the images fade exponentially at
+    // every new sweep, so that the cost doesn't depend on how many sweeps are shown.
+    class Persistence {
+        private:
+            typedef struct Layer {
+                std::vector<float> density;
+                ImVec4             color;
+                double             scale;
+                double             offset;
+            } Layer;
+
+            std::unordered_map<int, Layer> layers;
+            std::vector<uint32_t>          pixels;
+
+            unsigned int texture = 0;
+            bool         dirty   = false;
+
+            PlotTimeStyle time_style   = DATETIME;
+            double        sweep_length = 0;
+            double        origin       = 0;
+            long long     sweep        = 0;
+            size_t        splatted     = 0;
+
+            double y_min = 0;
+            double y_max = 1;
+
+            /**
+             * @brief Clear the images and fit the Y range to the whole capture
+             *
+             * @param data     channels
+             * @param times    timestamps
+             * @param channels shown channels' ids and colors
+             */
+            void restart(const std::unordered_map<int, Channel>& data, const std::vector<double>& times, const std::vector<std::pair<int, ImVec4>>& channels);
+
+            /**
+             * @brief Draw a segment into a layer, adding a hit to every pixel it crosses
+             *
+             * @param layer
+             * @param x0, y0 first point, in pixels
+             * @param x1, y1 second point, in pixels
+             */
+            static void splat(Layer& layer, float x0, float y0, float x1, float y1);
+
+            /**
+             * @brief Blend the layers into `pixels` and upload them to the texture
+             *
+             */
+            void upload();
+        public:
+            // fraction of intensity kept at every new sweep
+            float decay = 0.8f;
+
+            /**
+             * @brief Draw the samples received since the last update. Restarts when the channels, their transform,
+             * the time style, the sweep length change or the data is cleared.
+             *
+             * @param data     channels
+             * @param times    timestamps
+             * @param channels shown channels' ids and colors
+             * @param length   length of a sweep, in time units
+             * @param ts       time style of `times`
+             */
+            void update(const std::unordered_map<int, Channel>&    data,
+                        const std::vector<double>&                 times,
+                        const std::vector<std::pair<int, ImVec4>>& channels,
+                        double                                     length,
+                        PlotTimeStyle                              ts);
+
+            /**
+             * @brief Forget the accumulated sweeps, they are redrawn from the data on the next update
+             *
+             */
+            void reset() { layers.clear(); }
+
+            /**
+             * @brief Plot the image in the current plot, spanning a sweep on X and the Y range
+             *
+             */
+            void plot();
+
+            /**
+             * @brief Delete the texture. Must be called before the OpenGL context is destroyed.
+             *
+             */
+            void destroy();
+
+            double get_sweep_length() const { return sweep_length; }
+            double get_y_min() const { return y_min; }
+            double get_y_max() const { return y_max; }
+    };
+}
+
+#endif
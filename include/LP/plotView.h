@@ -1,11 +1,21 @@
 #ifndef __PLOT_VIEW_H__
 #define __PLOT_VIEW_H__
 
+#include "geometryPrep.h"
+#include "persistence.h"
+#include "spectrogram.h"
 #include "telemetry.h"
 #include <imgui.h>
 #include <unordered_map>
 
-#define PLOT_FUNC_SIZE 3
+#define PLOT_FUNC_SIZE 4
+
+#define LANE_MIN_HEIGHT 120.0f
+
+#define OVERVIEW_HEIGHT  80.0f
+#define OVERVIEW_BUCKETS 2048
+
+#define SPECTROGRAM_HEIGHT 200.0f
 
 namespace LP {
     typedef void (*PlotFunc)(const char*, const double*, const double*, int, int, int, int);
@@ -15,12 +25,20 @@ namespace LP {
         size_t combobox_func_index = 0;
         ImVec4 color;
         bool   show;
+
+        // bits drawn as digital lanes, 0 to plot the value
+        int bits = 0;
     } ChannelStyle;
 
     // general plot attributes
     typedef struct PlotStyle {
-        PlotTimeStyle time_style = DATETIME;
+        PlotTimeStyle time_style  = DATETIME;
         Limits        limits;
+        bool          strip_chart = false;
+        bool          persistence = false;
+
+        // id of the channel whose spectrogram is shown, 0 for none
+        int spectrogram_channel = 0;
     } PlotStyle;
 
     typedef struct plot_functions_t {
@@ -37,6 +55,29 @@ namespace LP {
             PlotStyle plot_style;
             size_t    combobox_time_index;
 
+            // channel ids in telemetry table order
+            std::vector<int> table_rows;
+
+            // sweeps accumulated by the persistence mode
+            Persistence persistence;
+
+            // waterfall of the channel selected in `plot_style`
+            Spectrogram spectrogram;
+
+            // time axis limits shared by the strip chart lanes
+            double lanes_x_min = 0;
+            double lanes_x_max = 1;
+
+            // view limits requested from the overview, applied to the plot on the next frame
+            bool   view_request = false;
+            double view_x_min   = 0;
+            double view_x_max   = 1;
+
+            // Y limits requested along with the view, e.g. when a file is opened
+            bool   view_y_request = false;
+            double view_y_min     = 0;
+            double view_y_max     = 1;
+
             /**
              * @brief initialize a new channel plot style with key `id`, or overwrite it if the key already exists
              * 
@@ -45,13 +86,21 @@ namespace LP {
             void channel_style_init(int id);
             
             /**
-             * @brief Renders a pop-up containing various channel configuration widgets
+             * @brief Renders a pop-up containing various channel configuration widgets. The pop-up ID is scoped by
+             * the caller's ID stack.
              * 
-             * @param id    channel id
+             * @param ch_id channel id
              * @param data  channel
              * @param style channel style
              */
-            void render_channel_settings(int id, Channel& data, ChannelStyle& style);
+            void render_channel_settings(int ch_id, Channel& data, ChannelStyle& style);
+
+            /**
+             * @brief `ImGui::InputText` callback growing the `std::string` passed as user data, so that it can be
+             * edited in place
+             * 
+             */
+            static int resize_string_callback(ImGuiInputTextCallbackData* data);
 
             /**
              * @brief Render a tooltip hoverable widget containing text
@@ -59,6 +108,107 @@ namespace LP {
              * @param message the string to be displayed
              */
             void render_tooltip(const char* message);
+
+            /**
+             * @brief Render every shown channel in its own plot lane, with an independent Y axis and linked X axes.
+             * Lanes scrolled out of view are not submitted.
+             * 
+             * @param data         channels
+             * @param times        timestamps
+             * @param prepared     points prepared for the current view, or nullptr
+             * @param app_state    the current app state (READING or IDLE)
+             * @param window_start start of the time window
+             * @param first        index of the first sample in the time window
+             * @param size         size of the lanes area
+             */
+            void render_lanes(std::unordered_map<int, Channel>& data, const std::vector<double>& times, const PreparedFrame* prepared, app_state_t app_state, double window_start, size_t first, ImVec2 size);
+
+            /**
+             * @brief Render the sweeps accumulated by the persistence mode, in a plot spanning a sweep on X
+             * 
+             * @param data         channels
+             * @param times        timestamps
+             * @param app_state    the current app state (READING or IDLE)
+             * @param sweep_length length of a sweep, in time units
+             * @param size         size of the plot
+             */
+            void render_persistence(const std::unordered_map<int, Channel>& data, const std::vector<double>& times, app_state_t app_state, double sweep_length, ImVec2 size);
+
+            /**
+             * @brief Render the spectrogram of a channel, with the time axis of the plot above
+             * 
+             * @param ch_id   channel id
+             * @param channel
+             * @param times   timestamps
+             */
+            void render_spectrogram(int ch_id, const Channel& channel, const std::vector<double>& times);
+
+            /**
+             * @brief Render a thin plot of the whole capture, drawn from the channels' min/max summaries, with a
+             * rectangle showing the main view that can be dragged and resized to move it
+             * 
+             * @param data      channels
+             * @param times     timestamps
+             * @param app_state the current app state (READING or IDLE)
+             */
+            void render_overview(std::unordered_map<int, Channel>& data, const std::vector<double>& times, app_state_t app_state);
+
+            /**
+             * @brief Plot a channel in the current plot with its style, from its prepared points if there are any,
+             * otherwise from every sample
+             * 
+             * @param ch_id    channel id
+             * @param channel
+             * @param times    timestamps
+             * @param prepared points prepared for the current view, or nullptr
+             */
+            void plot_channel(int ch_id, const Channel& channel, const std::vector<double>& times, const PreparedFrame* prepared);
+
+            /**
+             * @brief Plot the lowest bits of a channel's values as digital lanes, one point per transition in view
+             * 
+             * @param ch_id   channel id
+             * @param channel
+             * @param times   timestamps
+             */
+            void plot_bits(int ch_id, const Channel& channel, const std::vector<double>& times);
+
+            /**
+             * @brief Get the time range shown this frame
+             * 
+             * @param app_state    the current app state (READING or IDLE)
+             * @param window_start start of the time window
+             * @param last_time    last timestamp
+             * @return the view limits, only the X ones are meaningful
+             */
+            Limits current_view(app_state_t app_state, double window_start, double last_time) const;
+
+            /**
+             * @brief Ask the geometry worker for the points of the shown channels in a view
+             * 
+             * @param prep       geometry worker
+             * @param data       channels
+             * @param view       view limits
+             * @param plot_width plot width in pixels
+             * @param samples    current number of samples
+             */
+            void post_prep_request(GeometryPrep& prep, const std::unordered_map<int, Channel>& data, const Limits& view, float plot_width, size_t samples);
+
+            /**
+             * @brief Get the extents of the scaled values of a channel from the sample `first` on
+             * 
+             * @param channel
+             * @param times   timestamps
+             * @param first   index of the first sample
+             */
+            static Extents channel_extents(const Channel& channel, const std::vector<double>& times, size_t first);
+
+            /**
+             * @brief Set the Y axis limits of the current plot to the extents, if valid
+             * 
+             * @param extents
+             */
+            static void fit_y_axis(const Extents& extents);
         public:
             PlotView() : plot_style(), combobox_time_index(2) {}
 
@@ -66,13 +216,14 @@ namespace LP {
            * @brief Render the plot
            *
            * @param tel         Reference to a telemetry object containing all the channel's data
+           * @param prep        Geometry worker preparing the plotted points
            * @param app_state   The current app state (READING or IDLE)
            * @param pos_x       X position for the plot window
            * @param pos_y       Y position fot the plot window
            * @param width
            * @param height
            */
-            void render_plot(Telemetry& tel, app_state_t app_state, float pos_x, float pos_y, float width, float height);
+            void render_plot(Telemetry& tel, GeometryPrep& prep, app_state_t app_state, float pos_x, float pos_y, float width, float height);
 
             /**
              * @brief Render widgets used to interact and read received data 
@@ -95,6 +246,31 @@ namespace LP {
              */
             void render_data_format(Telemetry& tel, app_state_t app_state);
 
+            /**
+             * @brief Release the GL resources of the plot. Must be called before the OpenGL context is destroyed.
+             * 
+             */
+            void destroy()
+            {
+                persistence.destroy();
+                spectrogram.destroy();
+            }
+
+            /**
+             * @brief Show the given limits on the next frame, unless reading
+             * 
+             * @param limits
+             */
+            void show_limits(const Limits& limits)
+            {
+                view_x_min     = limits.x_min;
+                view_x_max     = limits.x_max;
+                view_y_min     = limits.y_min;
+                view_y_max     = limits.y_max;
+                view_request   = true;
+                view_y_request = true;
+            }
+
             /**
              * @brief Get the plot style object
              * 
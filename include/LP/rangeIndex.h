@@ -0,0 +1,90 @@
+#ifndef __RANGE_INDEX_H__
+#define __RANGE_INDEX_H__
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#define RANGE_INDEX_BLOCK_SIZE 64
+
+namespace LP {
+    // min/max pair of a range of values. NaN values are ignored.
+    typedef struct Extents {
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+
+        bool valid() const { return min <= max; }
+
+        void extend(double value)
+        {
+            if (value < min) min = value;
+            if (value > max) max = value;
+        }
+
+        void merge(const Extents& other)
+        {
+            if (other.min < min) min = other.min;
+            if (other.max > max) max = other.max;
+        }
+    } Extents;
+
+    // Min/max pyramid kept alongside a channel's values, used to answer range extents queries in O(log n)
+    // instead of scanning the whole range.
+    class RangeIndex {
+        private:
+            // levels[0] summarises blocks of RANGE_INDEX_BLOCK_SIZE values, every next level summarises pairs
+            // of entries of the level below
+            std::vector<std::vector<Extents>> levels;
+            size_t count = 0;
+
+            /**
+             * @brief Extend the extents with the raw values in [first, last)
+             */
+            static void scan(const std::vector<double>& values, size_t first, size_t last, Extents& result);
+        public:
+            /**
+             * @brief Add the next value of the series to the index
+             * 
+             * @param value 
+             */
+            void push(double value);
+
+            /**
+             * @brief Rebuild the index from scratch
+             * 
+             * @param values the whole series
+             */
+            void build(const std::vector<double>& values);
+
+            /**
+             * @brief Get the extents of the values in [first, last)
+             * 
+             * @param values the series this index was built from
+             * @param first  index of the first value
+             * @param last   index past the last value
+             * @return the extents, which are not valid if the range only contains NaNs or is empty
+             */
+            Extents query(const std::vector<double>& values, size_t first, size_t last) const;
+
+            /**
+             * @brief Get the extents of the whole series in O(1)
+             * 
+             */
+            Extents total() const;
+
+            /**
+             * @brief Get the finest level of the pyramid with at most `max_entries` entries, i.e. a downsampled
+             * summary of the whole series whose size doesn't depend on the series length
+             * 
+             * @param max_entries maximum number of entries
+             * @param block_size  set to the number of values summarised by each entry (the last one may be partial)
+             * @return the level entries, empty if the index is
+             */
+            const std::vector<Extents>& level(size_t max_entries, size_t& block_size) const;
+
+            void   clear();
+            size_t size() const { return count; }
+    };
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef __RECORD_INDEX_H__
+#define __RECORD_INDEX_H__
+
+#include "LP/shared.h"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define RECORD_INDEX_VERSION 1
+
+namespace LP {
+    // file of a rotated recording, with the time range of its rows
+    typedef struct RecordSegment {
+        std::string file;
+        double      first;
+        double      last;
+        size_t      rows;
+    } RecordSegment;
+
+    // `.lpidx` index of a rotated recording: the files of the set, oldest first, and the time range of each one, so
+    // that a time can be found in the set without opening its files. It's a small text file:
+    //
+    //   LPIDX;<version>;<DATETIME|ELAPSED>
+    //   <file name>;<first time>;<last time>;<rows>
+    //   ...
+    //
+    // File names are relative to the index's directory.
+    class RecordIndex {
+        private:
+            PlotTimeStyle              time_style = ELAPSED;
+            std::vector<RecordSegment> segments;
+            std::string                directory;
+        public:
+            /**
+             * @brief Read an index file
+             *
+             * @param path
+             * @return true if the file is a valid index
+             */
+            bool load(const std::string& path);
+
+            /**
+             * @brief Write the index, replacing the previous one at once so that it's never seen half written
+             *
+             * @param path
+             * @return true if the file was written
+             */
+            bool save(const std::string& path) const;
+
+            /**
+             * @brief Find the segment holding a time
+             *
+             * @param time in the index's time style
+             * @return index of the segment holding `time`, or of the first one after it; the segments' count if
+             * `time` is after the last one
+             */
+            size_t find(double time) const;
+
+            /**
+             * @brief Find the segments overlapping a time range
+             *
+             * @return the first segment and one past the last one
+             */
+            std::pair<size_t, size_t> find_range(double from, double to) const;
+
+            /**
+             * @brief Get the full path of a segment's file
+             *
+             */
+            std::string get_path(size_t segment) const;
+
+            std::vector<RecordSegment>&       get_segments() { return segments; }
+            const std::vector<RecordSegment>& get_segments() const { return segments; }
+
+            PlotTimeStyle get_time_style() const { return time_style; }
+            void          set_time_style(PlotTimeStyle ts) { time_style = ts; }
+            void          set_directory(const std::string& dir) { directory = dir; }
+
+            /**
+             * @brief Get the index path of a rotated recording: `x.csv` is indexed by `x.lpidx`
+             *
+             */
+            static std::string index_path(const std::string& base_path);
+
+            /**
+             * @brief Get the path of a rotated recording's file: `x.csv` is recorded to `x_0001.csv`, `x_0002.csv`...
+             *
+             */
+            static std::string segment_path(const std::string& base_path, size_t number);
+    };
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef __RECORDER_H__
+#define __RECORDER_H__
+
+#include "LP/gzipWriter.h"
+#include "LP/recordIndex.h"
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// how often the writer thread wakes up to write the committed rows
+#define RECORDER_WRITE_INTERVAL_MS 250
+
+#define RECORDER_SYNC_OPTIONS_SIZE 4
+
+#define RECORDER_ROTATION_OPTIONS_SIZE 5
+
+// files kept by a rotated recording, unless told otherwise
+#define RECORDER_KEEP_FILES 24
+
+namespace LP {
+    // how often the recorded file is flushed to the disk with fsync: never (left to the OS), after every write, or
+    // at most once every `interval_ms`
+    typedef struct SyncOption {
+        const char* label;
+        int         interval_ms;
+    } SyncOption;
+
+    inline constexpr std::array<SyncOption, RECORDER_SYNC_OPTIONS_SIZE> sync_options = {{{"OS default", -1},
+                                                                                          {"Every write", 0},
+                                                                                          {"Every 1 s", 1000},
+                                                                                          {"Every 10 s", 10000}}};
+
+    // when a recording moves on to its next file: once the current one holds `max_bytes` of CSV text, before
+    // compression, or has been recorded for `interval_s`; 0 disables either limit
+    typedef struct RotationOption {
+        const char* label;
+        size_t      max_bytes;
+        int         interval_s;
+    } RotationOption;
+
+    inline constexpr std::array<RotationOption, RECORDER_ROTATION_OPTIONS_SIZE> rotation_options = {
+        {{"Single file", 0, 0},
+         {"Every 100 MB", 100ull << 20, 0},
+         {"Every 1 GB", 1ull << 30, 0},
+         {"Every hour", 0, 3600},
+         {"Every day", 0, 86400}}};
+
+    // rotation of a recording, and how many of its files are kept; the oldest ones are deleted
+    typedef struct Rotation {
+        size_t max_bytes  = 0;
+        int    interval_s = 0;
+        size_t max_files  = RECORDER_KEEP_FILES;
+
+        bool enabled() const { return max_bytes > 0 || interval_s > 0; }
+    } Rotation;
+
+    // `Recorder` appends every row committed by the reading thread to a CSV file, in the `dump_data` layout, so that a
+    // capture survives a crash. The reading thread only copies the new rows into a pending batch; a writer thread
+    // formats the batch and appends it with a single write every RECORDER_WRITE_INTERVAL_MS. `.gz` recordings are
+    // compressed by a third thread, and flushed after every write, so that they can be read up to the last one.
+    //
+    // Long recordings can be rotated: the rows go to numbered files, each with its own header, and a `RecordIndex`
+    // lists their time ranges. Files are switched by the writer thread, between two writes, so the reading thread
+    // never waits for it.
+    class Recorder {
+        private:
+            std::thread             writer;
+            std::mutex              mtx;
+            std::condition_variable cv;
+            std::atomic<bool>       active = false;
+
+            // guarded by `mtx`
+            bool             running          = false;
+            Snapshot         pending;
+            size_t           recorded         = 0;
+            std::vector<int> channel_ids;
+            PlotTimeStyle    time_style       = ELAPSED;
+            int              sync_interval_ms = -1;
+
+            // used by the writer thread while running, `gzip` for compressed recordings
+            std::FILE* file = nullptr;
+            GzipWriter gzip;
+
+            // rotated recordings, used by the writer thread while running
+            std::string base_path;
+            Rotation    rotation;
+            RecordIndex index;
+            size_t      segment_number = 0;
+            size_t      segment_bytes  = 0;
+
+            std::chrono::steady_clock::time_point segment_start;
+
+            /**
+             * @brief Create a recorded file, gzip compressed if its path ends with `.gz`
+             *
+             */
+            bool open_file(const std::string& path);
+
+            /**
+             * @brief Close the recorded file
+             *
+             * @param sync_file if true, flush it to the disk first
+             * @return false if the file couldn't be written
+             */
+            bool close_file(bool sync_file);
+
+            /**
+             * @brief Close the current file of a rotated recording, open the next one and delete the oldest ones
+             *
+             * @param sync_file if true, flush the closed file to the disk
+             * @return false if the next file couldn't be created
+             */
+            bool rotate(bool sync_file);
+
+            /**
+             * @brief Writer loop: write the pending batch every RECORDER_WRITE_INTERVAL_MS, until stopped
+             *
+             */
+            void run();
+
+            /**
+             * @brief fsync the file
+             *
+             */
+            void sync() const;
+        public:
+            Recorder() = default;
+            ~Recorder();
+
+            Recorder(const Recorder&)            = delete;
+            Recorder& operator=(const Recorder&) = delete;
+
+            /**
+             * @brief Start recording the rows committed from now on. The columns are the channels existing when the
+             * first rows are committed.
+             *
+             * @param tel              recorded telemetry
+             * @param file_path        path to the CSV file, gzip compressed if it ends with `.gz`
+             * @param ts               time format (DATETIME or ELAPSED)
+             * @param sync_ms          fsync cadence, see `SyncOption`
+             * @param file_rotation    rotation of the recorded files; when enabled, `file_path` names the set: see
+             *                         `RecordIndex::segment_path` and `RecordIndex::index_path`
+             * @return true if the file was created
+             */
+            bool start(const Telemetry&   tel,
+                       const std::string& file_path,
+                       PlotTimeStyle      ts,
+                       int                sync_ms,
+                       const Rotation&    file_rotation = {});
+
+            /**
+             * @brief Write the pending rows and close the file
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Copy the rows added since the last commit into the pending batch. Called by the reading thread,
+             * with the data mutex held; returns at once when not recording.
+             *
+             * @param tel
+             */
+            void commit(const Telemetry& tel);
+
+            /**
+             * @brief Change the fsync cadence of the running recording
+             *
+             */
+            void set_sync_interval(int interval_ms);
+
+            /**
+             * @brief Check if the recording is running. It stops by itself if the file can't be written.
+             *
+             */
+            bool is_active() const { return active; }
+    };
+}
+
+#endif
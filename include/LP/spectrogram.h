@@ -0,0 +1,123 @@
+#ifndef __SPECTROGRAM_H__
+#define __SPECTROGRAM_H__
+
+#include "LP/shared.h"
+#include "LP/telemetry.h"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define SPECTROGRAM_FFT_SIZE 256
+#define SPECTROGRAM_HOP      64
+#define SPECTROGRAM_BINS     (SPECTROGRAM_FFT_SIZE / 2)
+#define SPECTROGRAM_COLUMNS  4096
+
+// dB below the loudest bin mapped to the colormap
+#define SPECTROGRAM_RANGE_DB 80.0f
+
+namespace LP {
+    // `Spectrogram` shows the short-time spectrum of a channel as a waterfall. New samples are handed to a worker
+    // thread, which computes a column every SPECTROGRAM_HOP samples; the UI thread uploads only the new columns into a
+    // texture used as a ring buffer, and shows it with a texture coordinates offset, wrapping around its end.
+    class Spectrogram {
+        private:
+            // worker state, guarded by `mtx`
+            std::thread             worker;
+            std::mutex              mtx;
+            std::condition_variable cv;
+            bool                    running    = false;
+            size_t                  generation = 0;
+            std::vector<double>     input_values;
+            std::vector<double>     input_times;
+            std::vector<float>      ready_columns;
+            std::vector<double>     ready_times;
+
+            // UI state
+            int           ch_id      = 0;
+            double        scale      = 1.0;
+            PlotTimeStyle time_style = DATETIME;
+            size_t        fed        = 0;
+
+            unsigned int              texture = 0;
+            size_t                    head    = 0;
+            size_t                    filled  = 0;
+            std::vector<double>       column_times;
+            std::vector<uint32_t>     column_pixels;
+            std::array<uint32_t, 256> colormap{};
+            float                     peak_db     = -200.0f;
+            double                    sample_rate = 0;
+
+            /**
+             * @brief Worker loop: compute the columns of the fed samples
+             *
+             */
+            void run();
+
+            /**
+             * @brief Stop and join the worker
+             *
+             */
+            void stop();
+
+            /**
+             * @brief Forget every sample and column, and discard the columns being computed
+             *
+             */
+            void restart();
+
+            /**
+             * @brief Create the texture and the colormap lookup table
+             *
+             */
+            void init_texture();
+
+            /**
+             * @brief Upload a column at the ring head and advance it
+             *
+             * @param power SPECTROGRAM_BINS values in dB
+             * @param time  timestamp of the last sample of the column
+             */
+            void upload_column(const float* power, double time);
+        public:
+            Spectrogram() = default;
+            ~Spectrogram();
+
+            Spectrogram(const Spectrogram&)            = delete;
+            Spectrogram& operator=(const Spectrogram&) = delete;
+
+            /**
+             * @brief Feed the samples received since the last update to the worker, and upload the columns it has
+             * computed. Restarts when the channel, its scale or the time style change, or the data is cleared.
+             *
+             * @param id      channel id
+             * @param channel
+             * @param times   timestamps
+             * @param ts      time style of `times`
+             */
+            void update(int id, const Channel& channel, const std::vector<double>& times, PlotTimeStyle ts);
+
+            /**
+             * @brief Plot the waterfall in the current plot, with time on X and frequency in Hz on Y
+             *
+             */
+            void plot() const;
+
+            /**
+             * @brief Stop the worker and delete the texture. Must be called before the OpenGL context is destroyed.
+             *
+             */
+            void destroy();
+
+            /**
+             * @brief Highest frequency shown, estimated from the timestamps
+             *
+             */
+            double get_nyquist() const { return sample_rate / 2.0; }
+    };
+}
+
+#endif
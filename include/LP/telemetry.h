@@ -1,20 +1,36 @@
 #ifndef __TELEMETRY_H__
 #define __TELEMETRY_H__
 
+#include "LP/rangeIndex.h"
 #include "LP/shared.h"
+#include <atomic>
 #include <chrono>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace LP {
     struct ChannelStyle;
 
+    // run of equal consecutive values of a channel, starting at the sample `first`
+    typedef struct ValueRun {
+        size_t first;
+        double value;
+    } ValueRun;
+
     // struct containing all the attributes and values of plot channels
     typedef struct Channel {
         std::string         name;
         std::vector<double> values;
+        RangeIndex          extents;
+
+        // value changes, which are rare for status words and let bitfields be drawn per transition. Only kept for
+        // the channels drawn as bitfields, up to the sample `runs_end`: see `Telemetry::extend_runs`
+        std::vector<ValueRun> runs;
+        size_t                runs_end = 0;
 
         double              scale;
         double              offset;
@@ -28,6 +44,16 @@ namespace LP {
         bool named            = false;
     } FrameFormat;
 
+    // copy of the data in a time window, taken under the data mutex and exported without holding it
+    typedef struct Snapshot {
+        PlotTimeStyle            time_style = ELAPSED;
+        std::vector<double>      times;
+        std::vector<std::string> names;
+
+        // scaled values of every shown channel, NaN where missing or outside of the Y limits
+        std::vector<std::vector<double>> columns;
+    } Snapshot;
+
     // Class responsible for all the operations performed on data read from the serial buffers
     class Telemetry {
         private:
@@ -47,6 +73,22 @@ namespace LP {
              * @return the modified string
              */
             static std::string format_special_chars(const char* s);
+
+            /**
+             * @brief Append a value to a channel, along with its range index
+             * 
+             * @param channel
+             * @param value
+             */
+            static void push_value(Channel& channel, double value);
+
+            /**
+             * @brief Parse valid data frames, with the given timestamps or the current ones
+             * 
+             * @param frame_stream valid frames, coming from `parse_serial`
+             * @param times        unix timestamp and elapsed time of the frames, if not the current ones
+             */
+            void parse_frames(const std::string& frame_stream, const std::optional<std::pair<double, double>>& times);
         public:
             FrameFormat frame_format;
 
@@ -72,7 +114,76 @@ namespace LP {
             void parse_frame(const std::string&  frame_stream);
 
             /**
-             * @brief Save data to a CSV file.
+             * @brief Parse valid data frames, stamping all of them with the given times instead of the current ones,
+             * e.g. when replaying recorded bytes
+             * 
+             * @param frame_stream valid frames, coming from `parse_serial`
+             * @param unix_time    unix timestamp of the frames
+             * @param elapsed_time elapsed time of the frames, in millis
+             */
+            void parse_frame(const std::string& frame_stream, double unix_time, double elapsed_time);
+
+            /**
+             * @brief Append a frame of already parsed values, one per channel starting from id 1, with its
+             * timestamps. Missing channels are created with the default name.
+             * 
+             * @param frame        channels' values
+             * @param unix_time    unix timestamp of the frame
+             * @param elapsed_time elapsed time of the frame, in millis
+             */
+            void push_frame(const std::vector<double>& frame, double unix_time, double elapsed_time);
+
+            /**
+             * @brief Append a block of already parsed rows, a column at a time. Missing channels are created with the
+             * default name; channels without a column get NaN values.
+             * 
+             * @param unix_times    `rows` unix timestamps
+             * @param elapsed_times `rows` elapsed times, in millis
+             * @param rows          number of rows
+             * @param columns       channel ids and their `rows` values
+             */
+            void push_columns(const double*                                    unix_times,
+                              const double*                                    elapsed_times,
+                              size_t                                           rows,
+                              const std::vector<std::pair<int, const double*>>& columns);
+
+            /**
+             * @brief Replace all the data with already filled columns, e.g. loaded from a file
+             * 
+             * @param unix_times    unix timestamps
+             * @param elapsed_times elapsed times, in millis
+             * @param channels      channels with as many values as timestamps, indexed with `index_channel`
+             */
+            void replace_data(std::vector<double>&&              unix_times,
+                              std::vector<double>&&              elapsed_times,
+                              std::unordered_map<int, Channel>&& channels);
+
+            /**
+             * @brief Rebuild the range index of a channel from its values, and its value runs if it keeps them
+             * 
+             * @param channel
+             */
+            static void index_channel(Channel& channel);
+
+            /**
+             * @brief Bring the value runs of a channel up to date with the values added since the last call
+             * 
+             * @param channel
+             */
+            static void extend_runs(Channel& channel);
+
+            /**
+             * @brief Bring the value runs of the channels drawn as bitfields up to date, and release the runs of the
+             * other channels. Called every frame before the channels are drawn, in any layout.
+             * 
+             * @param channels
+             * @param ch_styles plot channels style
+             */
+            static void update_runs(std::unordered_map<int, Channel>&            channels,
+                                    const std::unordered_map<int, ChannelStyle>& ch_styles);
+
+            /**
+             * @brief Save data to a CSV file, gzip compressed if the path ends with `.gz`.
              * 
              * @param path       path to the file where the data will be saved
              * @param limits     plot limits where the data will be taken
@@ -81,6 +192,32 @@ namespace LP {
              */
             void dump_data(const std::string& path, Limits limits, std::unordered_map<int, ChannelStyle> ch_styles, PlotTimeStyle ts = ELAPSED) const;
 
+            /**
+             * @brief Copy the shown channels' values within the limits, holding the data mutex only for the copy
+             * 
+             * @param limits     plot limits where the data will be taken
+             * @param ch_styles  plot channels style
+             * @param ts         time format (DATETIME or ELAPSED)
+             * @return the snapshot
+             */
+            Snapshot snapshot(Limits                                       limits,
+                              const std::unordered_map<int, ChannelStyle>& ch_styles,
+                              PlotTimeStyle                                ts) const;
+
+            /**
+             * @brief Write a snapshot to a CSV file, gzip compressed if the path ends with `.gz`
+             * 
+             * @param path     path to the file where the data will be saved
+             * @param snapshot
+             * @param progress if set, updated with the number of rows written
+             * @param cancel   if set, the write stops as soon as it becomes true
+             * @return true if the whole snapshot was written
+             */
+            static bool write_csv(const std::string&       path,
+                                  const Snapshot&          snapshot,
+                                  std::atomic<size_t>*     progress = nullptr,
+                                  const std::atomic<bool>* cancel   = nullptr);
+
             /**
              * @brief Get the actual unix time
              *
@@ -112,6 +249,10 @@ namespace LP {
             std::vector<double>* get_unix_timestamps()       { return &times_unix; };
             std::vector<double>* get_elapsed_timestamps()    { return &times_elapsed; };
 
+            const std::unordered_map<int, Channel>* get_data()  const { return &data; }
+            const std::vector<double>* get_unix_timestamps()    const { return &times_unix; };
+            const std::vector<double>* get_elapsed_timestamps() const { return &times_elapsed; };
+
             static std::string format_datetime(double unix_timestamp);
 
             std::mutex& get_data_mtx() const;
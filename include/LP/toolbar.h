@@ -1,27 +1,50 @@
 #ifndef __TOOLBAR_H__
 #define __TOOLBAR_H__
 
+#include "LP/recorder.h"
 #include "LP/shared.h"
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace LP {
+    // progress of a background save or load, shown in the toolbar
+    typedef struct JobProgress {
+        const char* label;
+        float       fraction;
+    } JobProgress;
+
     class ToolBar {
         private:
             std::optional<size_t> combobox_port_index;
             std::string current_port;
             size_t combobox_baud_index;
             size_t combobox_time_index;
+            size_t combobox_sync_index;
+            size_t combobox_replay_index;
+            size_t combobox_rotation_index;
+            int    keep_files;
             
             bool open_close_button;
             bool refresh_button;
             bool save_button;
             bool clear_button;
+            bool capture_frames_button;
+            bool capture_video_button;
+            bool open_button;
+            bool cancel_job_button;
+            bool record_button;
+            bool raw_record_button;
+            bool sync_changed;
         public:
             ToolBar()
               : combobox_port_index(std::nullopt), combobox_baud_index(6), combobox_time_index(2),
-                open_close_button(false), refresh_button(false), save_button(false), clear_button(false) {}
+                combobox_sync_index(0), combobox_replay_index(0), combobox_rotation_index(0),
+                keep_files(RECORDER_KEEP_FILES),
+                open_close_button(false), refresh_button(false), save_button(false), clear_button(false),
+                capture_frames_button(false), capture_video_button(false), open_button(false),
+                cancel_job_button(false), record_button(false), raw_record_button(false),
+                sync_changed(false) {}
 
           /**
            * @brief Update the selected serial port based on the actual available ports
@@ -35,9 +58,19 @@ namespace LP {
              * 
              * @param app_state     the current application state (either READING or IDLE)
              * @param no_telemetry  boolean used to check if there are already plotted values
-             * @param serial_ports  array of available serial ports
+             * @param capturing       boolean used to check if the plot is being captured
+             * @param recording       boolean used to check if the received data is being recorded to disk
+             * @param raw_recording   boolean used to check if the received bytes are being recorded to disk
+             * @param job             progress of the running save or load, if any
+             * @param serial_ports    array of available serial ports
              */
-            void render(app_state_t app_state, bool no_telemetry, const std::vector<std::string>& serial_ports);
+            void render(app_state_t                     app_state,
+                        bool                            no_telemetry,
+                        bool                            capturing,
+                        bool                            recording,
+                        bool                            raw_recording,
+                        std::optional<JobProgress>      job,
+                        const std::vector<std::string>& serial_ports);
 
             /**
              * @brief Get the new app state
@@ -54,6 +87,17 @@ namespace LP {
             [[nodiscard]] inline size_t getComboboxBaudIndex()                const { return combobox_baud_index; }
             [[nodiscard]] inline bool getOpenCloseButton()                    const { return open_close_button; }
             [[nodiscard]] inline bool getRefreshButton()                      const { return refresh_button; }
+            [[nodiscard]] inline bool getCaptureFramesButton()                const { return capture_frames_button; }
+            [[nodiscard]] inline bool getCaptureVideoButton()                 const { return capture_video_button; }
+            [[nodiscard]] inline bool getOpenButton()                         const { return open_button; }
+            [[nodiscard]] inline bool getCancelJobButton()                    const { return cancel_job_button; }
+            [[nodiscard]] inline bool getRecordButton()                       const { return record_button; }
+            [[nodiscard]] inline bool getRawRecordButton()                    const { return raw_record_button; }
+            [[nodiscard]] inline bool getSyncChanged()                        const { return sync_changed; }
+            [[nodiscard]] inline size_t getComboboxReplayIndex()              const { return combobox_replay_index; }
+            [[nodiscard]] inline size_t getComboboxSyncIndex()                const { return combobox_sync_index; }
+            [[nodiscard]] inline size_t getComboboxRotationIndex()            const { return combobox_rotation_index; }
+            [[nodiscard]] inline int getKeepFiles()                           const { return keep_files; }
             [[nodiscard]] inline std::string getCurrentPort()                 const { return current_port; }
 
             inline void setClearButton(const bool value)                          { clear_button = value; }
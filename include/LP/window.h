@@ -5,6 +5,7 @@
 #include <functional>
 #include <imgui.h>
 #include <string>
+#include <vector>
 
 struct GLFWwindow;
 struct ImGuiIO;
@@ -12,6 +13,12 @@ struct ImGuiStyle;
 struct ImPlotStyle;
 
 namespace LP {
+    // file type of the file dialogs: description and comma separated extensions
+    typedef struct FileFilter {
+        const char* name;
+        const char* spec;
+    } FileFilter;
+
     class Window {
         private: 
             static GLFWwindow*  window;
@@ -55,9 +62,19 @@ namespace LP {
              * @brief Render the Save file dialog
              * 
              * @param default_path default save path
+             * @param filters      file types, the first one is selected
              * @return select save path
              */
-            static std::string render_save_fd(const char* default_name);
+            static std::string render_save_fd(const char*                    default_name,
+                                              const std::vector<FileFilter>& filters = {{"CSV File", "csv"}});
+
+            /**
+             * @brief Render the Open file dialog
+             * 
+             * @param filters file types, the first one is selected
+             * @return selected path, or an empty string
+             */
+            static std::string render_open_fd(const std::vector<FileFilter>& filters);
 
             /**
              * @brief GLFW window close calls
@@ -0,0 +1,553 @@
+#include <LP/arrowFile.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+    constexpr char FILE_MAGIC[8] = {'A', 'R', 'R', 'O', 'W', '1', '\0', '\0'};
+
+    constexpr uint32_t CONTINUATION = 0xFFFFFFFF;
+
+    // enum values of the Arrow format's Schema.fbs and Message.fbs
+    constexpr int16_t METADATA_V5         = 4;
+    constexpr uint8_t HEADER_SCHEMA       = 1;
+    constexpr uint8_t HEADER_RECORD_BATCH = 3;
+    constexpr uint8_t TYPE_FLOATING_POINT = 3;
+    constexpr uint8_t TYPE_TIMESTAMP      = 10;
+    constexpr int16_t PRECISION_DOUBLE    = 2;
+    constexpr int16_t TIME_UNIT_MICROS    = 2;
+
+    // structs of the Arrow format, laid out as flatbuffers store them
+    typedef struct FieldNode {
+        int64_t length;
+        int64_t null_count;
+    } FieldNode;
+
+    typedef struct BufferRef {
+        int64_t offset;
+        int64_t length;
+    } BufferRef;
+
+    typedef struct Block {
+        int64_t offset;
+        int32_t metadata_length;
+        int32_t padding = 0;
+        int64_t body_length;
+    } Block;
+
+    // === flatbuffers ===
+
+    struct FbObject;
+
+    // table field: an inline scalar, or an offset to another object
+    typedef struct FbField {
+        uint16_t                  slot;
+        std::vector<uint8_t>      scalar;
+        std::shared_ptr<FbObject> child;
+    } FbField;
+
+    // table, vector of tables, vector of structs or string
+    typedef struct FbObject {
+        enum Kind { TABLE, TABLE_VECTOR, STRUCT_VECTOR, STRING } kind = TABLE;
+
+        std::vector<FbField>  fields;
+        std::vector<FbObject> items;
+        std::vector<uint8_t>  bytes;
+        size_t                count = 0;
+        size_t                align = 4;
+    } FbObject;
+
+    template <typename T> FbField scalar(const uint16_t slot, const T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        FbField field = {slot, std::vector<uint8_t>(sizeof(T)), nullptr};
+        std::memcpy(field.scalar.data(), &value, sizeof(T));
+
+        return field;
+    }
+
+    FbField child(const uint16_t slot, FbObject object)
+    {
+        return {slot, {}, std::make_shared<FbObject>(std::move(object))};
+    }
+
+    FbObject table(std::vector<FbField> fields)
+    {
+        FbObject object;
+        object.fields = std::move(fields);
+
+        return object;
+    }
+
+    FbObject tables(std::vector<FbObject> items)
+    {
+        FbObject object;
+        object.kind  = FbObject::TABLE_VECTOR;
+        object.items = std::move(items);
+
+        return object;
+    }
+
+    template <typename T> FbObject structs(const std::vector<T>& items)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        FbObject object;
+        object.kind  = FbObject::STRUCT_VECTOR;
+        object.count = items.size();
+        object.align = std::max<size_t>(4, alignof(T));
+        object.bytes.resize(items.size() * sizeof(T));
+
+        if (!items.empty())
+            std::memcpy(object.bytes.data(), items.data(), object.bytes.size());
+
+        return object;
+    }
+
+    FbObject string(const std::string_view value)
+    {
+        FbObject object;
+        object.kind  = FbObject::STRING;
+        object.count = value.size();
+        object.bytes.assign(value.begin(), value.end());
+
+        return object;
+    }
+
+    // Minimal flatbuffer encoder. Objects are written parents first, so that every offset points forward, as the
+    // format wants; every table gets its own vtable, right before it.
+    class FbWriter {
+        private:
+            std::vector<uint8_t> buf;
+
+            template <typename T> void put(const T value)
+            {
+                const size_t pos = buf.size();
+
+                buf.resize(pos + sizeof(T));
+                std::memcpy(buf.data() + pos, &value, sizeof(T));
+            }
+
+            void pad_to(const size_t align)
+            {
+                buf.resize((buf.size() + align - 1) / align * align, 0);
+            }
+
+            // offsets are relative to where they're stored
+            void patch(const size_t at, const size_t target)
+            {
+                const auto offset = static_cast<uint32_t>(target - at);
+
+                std::memcpy(buf.data() + at, &offset, sizeof(offset));
+            }
+
+            static size_t inline_size(const FbField& field) { return field.child ? 4 : field.scalar.size(); }
+
+            size_t write(const FbObject& object)
+            {
+                switch (object.kind)
+                {
+                case FbObject::TABLE:
+                    return write_table(object);
+                case FbObject::TABLE_VECTOR:
+                {
+                    pad_to(4);
+
+                    const size_t start = buf.size();
+                    put<uint32_t>(static_cast<uint32_t>(object.items.size()));
+                    buf.resize(buf.size() + 4 * object.items.size(), 0);
+
+                    for (size_t i = 0; i < object.items.size(); i++)
+                    {
+                        patch(start + 4 + 4 * i, write(object.items[i]));
+                    }
+
+                    return start;
+                }
+                case FbObject::STRUCT_VECTOR:
+                {
+                    // the elements, after the length, are aligned
+                    pad_to(4);
+
+                    while ((buf.size() + 4) % object.align != 0)
+                        put<uint32_t>(0);
+
+                    const size_t start = buf.size();
+                    put<uint32_t>(static_cast<uint32_t>(object.count));
+                    buf.insert(buf.end(), object.bytes.begin(), object.bytes.end());
+
+                    return start;
+                }
+                case FbObject::STRING:
+                default:
+                {
+                    pad_to(4);
+
+                    const size_t start = buf.size();
+                    put<uint32_t>(static_cast<uint32_t>(object.count));
+                    buf.insert(buf.end(), object.bytes.begin(), object.bytes.end());
+                    buf.push_back(0);
+
+                    return start;
+                }
+                }
+            }
+
+            size_t write_table(const FbObject& object)
+            {
+                // the inline fields by decreasing size follow the vtable offset, so that they're all aligned
+                std::vector<const FbField*> order;
+
+                for (const FbField& field : object.fields)
+                    order.push_back(&field);
+
+                std::ranges::stable_sort(order, std::greater{}, [](const FbField* f) { return inline_size(*f); });
+
+                uint16_t slots       = 0;
+                size_t   table_align = 4;
+
+                std::vector<size_t> offsets(order.size());
+                size_t              size = 4;
+
+                for (size_t i = 0; i < order.size(); i++)
+                {
+                    const size_t field_size = inline_size(*order[i]);
+
+                    size       = (size + field_size - 1) / field_size * field_size;
+                    offsets[i] = size;
+                    size      += field_size;
+
+                    slots       = std::max<uint16_t>(slots, order[i]->slot + 1);
+                    table_align = std::max(table_align, field_size);
+                }
+
+                // vtable: its size, the table's size and the offset of every field, 0 for absent ones
+                pad_to(2);
+
+                const size_t vtable = buf.size();
+                put<uint16_t>(static_cast<uint16_t>(4 + 2 * slots));
+                put<uint16_t>(static_cast<uint16_t>(size));
+
+                for (uint16_t slot = 0; slot < slots; slot++)
+                {
+                    uint16_t offset = 0;
+
+                    for (size_t i = 0; i < order.size(); i++)
+                    {
+                        if (order[i]->slot == slot)
+                            offset = static_cast<uint16_t>(offsets[i]);
+                    }
+
+                    put<uint16_t>(offset);
+                }
+
+                // table
+                pad_to(table_align);
+
+                const size_t start = buf.size();
+                put<int32_t>(static_cast<int32_t>(start - vtable));
+                buf.resize(start + size, 0);
+
+                for (size_t i = 0; i < order.size(); i++)
+                {
+                    if (!order[i]->child)
+                        std::memcpy(buf.data() + start + offsets[i], order[i]->scalar.data(), order[i]->scalar.size());
+                }
+
+                for (size_t i = 0; i < order.size(); i++)
+                {
+                    if (order[i]->child)
+                        patch(start + offsets[i], write(*order[i]->child));
+                }
+
+                return start;
+            }
+        public:
+            /**
+             * @brief Encode a root table, padded to 8 bytes
+             *
+             */
+            std::vector<uint8_t> finish(const FbObject& root)
+            {
+                buf.clear();
+                put<uint32_t>(0);
+                patch(0, write(root));
+                pad_to(8);
+
+                return std::move(buf);
+            }
+    };
+
+    // === Arrow metadata ===
+
+    FbObject key_value(const std::string_view key, const std::string_view value)
+    {
+        return table({child(0, string(key)), child(1, string(value))});
+    }
+
+    FbObject field(const std::string_view name,
+                   const uint8_t          type_type,
+                   FbObject               type,
+                   std::vector<FbObject>  metadata = {})
+    {
+        std::vector<FbField> fields = {
+            child(0, string(name)),
+            scalar<uint8_t>(1, 1),
+            scalar<uint8_t>(2, type_type),
+            child(3, std::move(type)),
+            child(5, tables({})),
+        };
+
+        if (!metadata.empty())
+            fields.push_back(child(6, tables(std::move(metadata))));
+
+        return table(std::move(fields));
+    }
+
+    FbObject message(const uint8_t header_type, FbObject header, const int64_t body_length)
+    {
+        return table({scalar<int16_t>(0, METADATA_V5),
+                      scalar<uint8_t>(1, header_type),
+                      child(2, std::move(header)),
+                      scalar<int64_t>(3, body_length)});
+    }
+
+    // encapsulated message: continuation marker, metadata length, metadata padded to 8 bytes and body
+    Block write_message(std::ofstream& out, uint64_t& position, const FbObject& metadata, const std::string& body)
+    {
+        const std::vector<uint8_t> encoded = FbWriter().finish(metadata);
+
+        const uint32_t length = static_cast<uint32_t>(encoded.size());
+
+        out.write(reinterpret_cast<const char*>(&CONTINUATION), 4);
+        out.write(reinterpret_cast<const char*>(&length), 4);
+        out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        out.write(body.data(), static_cast<std::streamsize>(body.size()));
+
+        const Block block = {static_cast<int64_t>(position), static_cast<int32_t>(8 + encoded.size()), 0,
+                             static_cast<int64_t>(body.size())};
+
+        position += 8 + encoded.size() + body.size();
+
+        return block;
+    }
+
+    // column set of a record batch body
+    struct BatchBody {
+        std::string            body;
+        std::vector<FieldNode> nodes;
+        std::vector<BufferRef> buffers;
+
+        void add_buffer(const void* data, const size_t size)
+        {
+            buffers.push_back({static_cast<int64_t>(body.size()), static_cast<int64_t>(size)});
+
+            body.append(static_cast<const char*>(data), size);
+            body.resize((body.size() + ARROW_ALIGNMENT - 1) / ARROW_ALIGNMENT * ARROW_ALIGNMENT, '\0');
+        }
+
+        // a column without nulls, whose validity bitmap can be left out
+        void add_column(const void* data, const size_t rows, const size_t value_size)
+        {
+            nodes.push_back({static_cast<int64_t>(rows), 0});
+            add_buffer(nullptr, 0);
+            add_buffer(data, rows * value_size);
+        }
+
+        // a double column whose NaN values are null
+        void add_double_column(const double* values, const size_t rows)
+        {
+            const size_t nulls = std::count_if(values, values + rows, [](const double v) { return std::isnan(v); });
+
+            if (nulls == 0)
+            {
+                add_column(values, rows, sizeof(double));
+                return;
+            }
+
+            std::vector<uint8_t> validity((rows + 7) / 8, 0);
+
+            for (size_t i = 0; i < rows; i++)
+            {
+                if (!std::isnan(values[i]))
+                    validity[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+            }
+
+            nodes.push_back({static_cast<int64_t>(rows), static_cast<int64_t>(nulls)});
+            add_buffer(validity.data(), validity.size());
+            add_buffer(values, rows * sizeof(double));
+        }
+    };
+
+    struct ArrowChannel {
+        int         id;
+        std::string name;
+        double      scale;
+        double      offset;
+    };
+}
+
+bool LP::ArrowFile::save(const std::string&       path,
+                         const Telemetry&         tel,
+                         std::atomic<size_t>*     progress,
+                         const std::atomic<bool>* cancel)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+    if (!out.is_open())
+    {
+        std::cerr << "Error while opening Arrow file." << std::endl;
+        return false;
+    }
+
+    std::vector<ArrowChannel> channels;
+    size_t                    rows;
+
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        rows = tel.get_unix_timestamps()->size();
+
+        for (const auto& [id, channel] : *tel.get_data())
+        {
+            channels.push_back({id, channel.name, channel.scale, channel.offset});
+        }
+    }
+
+    std::ranges::sort(channels, {}, &ArrowChannel::id);
+
+    // === schema ===
+    std::vector<FbObject> fields = {
+        field("time", TYPE_TIMESTAMP, table({scalar<int16_t>(0, TIME_UNIT_MICROS), child(1, string("UTC"))})),
+        field("elapsed", TYPE_FLOATING_POINT, table({scalar<int16_t>(0, PRECISION_DOUBLE)})),
+    };
+
+    for (const ArrowChannel& channel : channels)
+    {
+        fields.push_back(field(channel.name,
+                               TYPE_FLOATING_POINT,
+                               table({scalar<int16_t>(0, PRECISION_DOUBLE)}),
+                               {key_value("id", std::format("{}", channel.id)),
+                                key_value("scale", std::format("{}", channel.scale)),
+                                key_value("offset", std::format("{}", channel.offset))}));
+    }
+
+    // little endian
+    const FbObject schema = table({scalar<int16_t>(0, 0), child(1, tables(std::move(fields)))});
+
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+
+    uint64_t position = sizeof(FILE_MAGIC);
+
+    write_message(out, position, message(HEADER_SCHEMA, schema, 0), "");
+
+    // === record batches ===
+    std::vector<Block>   batches;
+    std::vector<double>  block;
+    std::vector<int64_t> micros;
+
+    for (size_t first = 0; first < rows; first += ARROW_BATCH_ROWS)
+    {
+        const size_t count = std::min<size_t>(ARROW_BATCH_ROWS, rows - first);
+
+        block.assign(count * (2 + channels.size()), std::nan(""));
+
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+
+            const std::vector<double>& times_unix    = *tel.get_unix_timestamps();
+            const std::vector<double>& times_elapsed = *tel.get_elapsed_timestamps();
+
+            if (times_unix.size() < first + count)
+            {
+                std::cerr << "The data was cleared while saving the Arrow file." << std::endl;
+                return false;
+            }
+
+            std::copy_n(times_unix.begin() + first, count, block.begin());
+            std::copy_n(times_elapsed.begin() + first, count, block.begin() + count);
+
+            for (size_t c = 0; c < channels.size(); c++)
+            {
+                const auto channel = tel.get_data()->find(channels[c].id);
+
+                if (channel == tel.get_data()->end() || channel->second.values.size() <= first)
+                    continue;
+
+                const std::vector<double>& values = channel->second.values;
+
+                std::copy_n(values.begin() + first, std::min(count, values.size() - first),
+                            block.begin() + (2 + c) * count);
+            }
+        }
+
+        micros.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            micros[i] = std::llround(block[i] * 1e6);
+        }
+
+        BatchBody batch;
+        batch.add_column(micros.data(), count, sizeof(int64_t));
+
+        for (size_t c = 1; c < 2 + channels.size(); c++)
+        {
+            batch.add_double_column(block.data() + c * count, count);
+        }
+
+        const FbObject record_batch = table({scalar<int64_t>(0, static_cast<int64_t>(count)),
+                                             child(1, structs(batch.nodes)),
+                                             child(2, structs(batch.buffers))});
+
+        batches.push_back(write_message(out,
+                                        position,
+                                        message(HEADER_RECORD_BATCH, record_batch,
+                                                static_cast<int64_t>(batch.body.size())),
+                                        batch.body));
+
+        if (progress != nullptr)
+            progress->store(first + count, std::memory_order_relaxed);
+
+        if (cancel != nullptr && cancel->load(std::memory_order_relaxed))
+            return false;
+    }
+
+    // === end of stream and footer ===
+    const uint32_t eos[2] = {CONTINUATION, 0};
+    out.write(reinterpret_cast<const char*>(eos), sizeof(eos));
+
+    const std::vector<uint8_t> footer = FbWriter().finish(table({scalar<int16_t>(0, METADATA_V5),
+                                                                 child(1, schema),
+                                                                 child(2, structs(std::vector<Block>{})),
+                                                                 child(3, structs(batches))}));
+
+    const auto footer_length = static_cast<int32_t>(footer.size());
+
+    out.write(reinterpret_cast<const char*>(footer.data()), static_cast<std::streamsize>(footer.size()));
+    out.write(reinterpret_cast<const char*>(&footer_length), sizeof(footer_length));
+    out.write(FILE_MAGIC, 6);
+    out.close();
+
+    if (out.fail())
+    {
+        std::cerr << "Error while writing Arrow file." << std::endl;
+        return false;
+    }
+
+    return true;
+}
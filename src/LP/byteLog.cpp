@@ -0,0 +1,251 @@
+#include <LP/byteLog.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr char MAGIC[8] = {'L', 'P', 'R', 'A', 'W', '\r', '\n', '\x1A'};
+
+    // magic and version
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + sizeof(uint32_t);
+
+    // arrival time and size
+    constexpr size_t RECORD_HEADER_SIZE = sizeof(double) + sizeof(uint32_t);
+
+    // stdio buffer of the recorded file, so that most chunks are only copied
+    constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+}
+
+bool LP::ByteRecorder::start(const std::string& path)
+{
+    stop();
+
+    std::lock_guard lock(mtx);
+
+    file = std::fopen(path.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        std::cerr << "Error while opening raw capture file." << std::endl;
+        return false;
+    }
+
+    std::setvbuf(file, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+
+    const uint32_t version = BYTE_LOG_VERSION;
+
+    std::fwrite(MAGIC, 1, sizeof(MAGIC), file);
+    std::fwrite(&version, sizeof(version), 1, file);
+
+    active = true;
+
+    return true;
+}
+
+void LP::ByteRecorder::stop()
+{
+    std::lock_guard lock(mtx);
+
+    active = false;
+
+    if (file != nullptr)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+void LP::ByteRecorder::write(const std::vector<char>& bytes, const double unix_time)
+{
+    if (!active || bytes.empty())
+    {
+        return;
+    }
+
+    std::lock_guard lock(mtx);
+
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    const auto size = static_cast<uint32_t>(bytes.size());
+
+    std::fwrite(&unix_time, sizeof(unix_time), 1, file);
+    std::fwrite(&size, sizeof(size), 1, file);
+
+    if (std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size())
+    {
+        std::cerr << "Error while writing raw capture file, the recording is stopped." << std::endl;
+
+        active = false;
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+LP::ByteReplay::~ByteReplay()
+{
+    stop();
+}
+
+bool LP::ByteReplay::start(Telemetry& tel, const std::string& path, const double multiplier)
+{
+    poll();
+
+    if (running)
+    {
+        return false;
+    }
+
+    const auto invalid = [this, &path]()
+    {
+        std::cerr << "Error while opening " << path << ": not a valid raw capture file." << std::endl;
+        file.close();
+        return false;
+    };
+
+    if (!file.open(path) || file.get_size() < HEADER_SIZE || std::memcmp(file.get_data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        return invalid();
+    }
+
+    uint32_t version;
+    std::memcpy(&version, file.get_data() + sizeof(MAGIC), sizeof(version));
+
+    if (version != BYTE_LOG_VERSION)
+    {
+        return invalid();
+    }
+
+    // index the records; a record cut short by a crash is left out
+    records.clear();
+
+    for (size_t offset = HEADER_SIZE; offset + RECORD_HEADER_SIZE <= file.get_size();)
+    {
+        uint32_t size;
+        std::memcpy(&size, file.get_data() + offset + sizeof(double), sizeof(size));
+
+        if (offset + RECORD_HEADER_SIZE + size > file.get_size())
+        {
+            break;
+        }
+
+        records.push_back(offset);
+        offset += RECORD_HEADER_SIZE + size;
+    }
+
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        tel.clear(true);
+        tel.set_start_time();
+    }
+
+    speed        = multiplier;
+    cancelled    = false;
+    records_done = 0;
+    running      = true;
+
+    worker = std::thread(&ByteReplay::run, this, std::ref(tel));
+
+    return true;
+}
+
+void LP::ByteReplay::run(Telemetry& tel)
+{
+    using clock = std::chrono::steady_clock;
+
+    const char* data = file.get_data();
+
+    double first_time = 0;
+
+    if (!records.empty())
+    {
+        std::memcpy(&first_time, data + records.front(), sizeof(first_time));
+    }
+
+    const auto start = clock::now();
+    size_t     bytes = 0;
+
+    std::vector<char> buffer;
+
+    for (const size_t offset : records)
+    {
+        double   time;
+        uint32_t size;
+        std::memcpy(&time, data + offset, sizeof(time));
+        std::memcpy(&size, data + offset + sizeof(time), sizeof(size));
+
+        // keep the recorded pace, in short sleeps so that a cancel isn't held up by long pauses
+        if (speed > 0)
+        {
+            const auto due = start + std::chrono::duration_cast<clock::duration>(
+                                         std::chrono::duration<double>((time - first_time) / speed));
+
+            while (!cancelled && clock::now() < due)
+            {
+                const clock::duration left = due - clock::now();
+
+                std::this_thread::sleep_for(std::min<clock::duration>(left, std::chrono::milliseconds(50)));
+            }
+        }
+
+        if (cancelled)
+        {
+            break;
+        }
+
+        buffer.assign(data + offset + RECORD_HEADER_SIZE, data + offset + RECORD_HEADER_SIZE + size);
+
+        if (std::string frame_stream = tel.parse_serial(buffer); !frame_stream.empty())
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+            tel.parse_frame(frame_stream, time, (time - first_time) * 1000.0);
+        }
+
+        bytes += size;
+        records_done++;
+    }
+
+    const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    std::cout << "Replayed " << bytes << " bytes in " << seconds << " s ("
+              << (seconds > 0 ? bytes / seconds / 1e6 : 0.0) << " MB/s)" << std::endl;
+
+    file.close();
+
+    running = false;
+}
+
+void LP::ByteReplay::poll()
+{
+    if (!running && worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void LP::ByteReplay::stop()
+{
+    cancelled = true;
+
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+float LP::ByteReplay::get_progress() const
+{
+    return records.empty() ? 0.0f
+                           : std::min(1.0f, static_cast<float>(records_done) / static_cast<float>(records.size()));
+}
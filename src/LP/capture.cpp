@@ -0,0 +1,362 @@
+#include <LP/capture.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <glad/glad.h>
+#include <imgui.h>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+bool            LP::Capture::active       = false;
+LP::CaptureMode LP::Capture::mode         = CAPTURE_PNG_FRAMES;
+std::string     LP::Capture::path;
+size_t          LP::Capture::frame_count  = 0;
+size_t          LP::Capture::dropped      = 0;
+float           LP::Capture::region[4]    = {0, 0, 0, 0};
+int             LP::Capture::video_width  = 0;
+int             LP::Capture::video_height = 0;
+
+unsigned int LP::Capture::pbo[2]         = {0, 0};
+bool         LP::Capture::pbo_pending[2] = {false, false};
+int          LP::Capture::pbo_width[2]   = {0, 0};
+int          LP::Capture::pbo_height[2]  = {0, 0};
+size_t       LP::Capture::pbo_size[2]    = {0, 0};
+size_t       LP::Capture::pbo_index      = 0;
+
+std::thread                    LP::Capture::writer;
+std::mutex                     LP::Capture::queue_mtx;
+std::condition_variable        LP::Capture::queue_cv;
+std::deque<LP::Capture::Frame> LP::Capture::queue;
+bool                           LP::Capture::writing = false;
+std::ofstream                  LP::Capture::video;
+
+bool LP::Capture::start(const std::string& file_path, const CaptureMode capture_mode)
+{
+    // buffer mapping needs OpenGL 3.0
+    if (active || !GLAD_GL_VERSION_3_0)
+    {
+        return false;
+    }
+
+    if (capture_mode == CAPTURE_RAW_VIDEO)
+    {
+        video.open(file_path, std::ios::binary | std::ios::trunc);
+
+        if (!video.is_open())
+        {
+            return false;
+        }
+    }
+
+    if (pbo[0] == 0)
+    {
+        glGenBuffers(2, pbo);
+    }
+
+    mode         = capture_mode;
+    path         = file_path;
+    frame_count  = 0;
+    dropped      = 0;
+    video_width  = 0;
+    video_height = 0;
+    pbo_index    = 0;
+    active       = true;
+    writing      = true;
+
+    writer = std::thread(&Capture::write_loop);
+
+    return true;
+}
+
+void LP::Capture::stop()
+{
+    if (!active)
+    {
+        return;
+    }
+
+    // the oldest read back first, so that the frames stay in order
+    collect(pbo_index);
+    collect(pbo_index ^ 1);
+
+    active = false;
+
+    {
+        std::lock_guard lock(queue_mtx);
+        writing = false;
+    }
+
+    queue_cv.notify_one();
+
+    if (writer.joinable())
+    {
+        writer.join();
+    }
+
+    if (video.is_open())
+    {
+        video.close();
+    }
+
+    if (dropped > 0)
+    {
+        std::cerr << "Capture: " << dropped << " frames dropped, the disk could not keep up" << std::endl;
+    }
+}
+
+void LP::Capture::set_region(const float x, const float y, const float width, const float height)
+{
+    region[0] = x;
+    region[1] = y;
+    region[2] = width;
+    region[3] = height;
+}
+
+void LP::Capture::capture()
+{
+    if (!active)
+    {
+        return;
+    }
+
+    // the read back issued on the previous frame has completed by now
+    collect(pbo_index ^ 1);
+
+    const ImGuiIO& io    = ImGui::GetIO();
+    const ImVec2   scale = io.DisplayFramebufferScale;
+
+    const int fb_width  = static_cast<int>(io.DisplaySize.x * scale.x);
+    const int fb_height = static_cast<int>(io.DisplaySize.y * scale.y);
+
+    // GL rows go from the bottom
+    const int x      = std::clamp(static_cast<int>(region[0] * scale.x), 0, fb_width);
+    const int top    = std::clamp(static_cast<int>(region[1] * scale.y), 0, fb_height);
+    const int width  = std::clamp(static_cast<int>(region[2] * scale.x), 0, fb_width - x);
+    const int height = std::clamp(static_cast<int>(region[3] * scale.y), 0, fb_height - top);
+    const int y      = fb_height - top - height;
+
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+
+    if (mode == CAPTURE_RAW_VIDEO)
+    {
+        if (video_width == 0)
+        {
+            video_width  = width;
+            video_height = height;
+        }
+        else if (width != video_width || height != video_height)
+        {
+            std::cerr << "Capture: the plot was resized, the raw video stream is stopped" << std::endl;
+            stop();
+            return;
+        }
+    }
+
+    const size_t slot = pbo_index;
+    const size_t size = static_cast<size_t>(width) * height * 4;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[slot]);
+
+    if (pbo_size[slot] != size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        pbo_size[slot] = size;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    pbo_pending[slot] = true;
+    pbo_width[slot]   = width;
+    pbo_height[slot]  = height;
+    pbo_index         = slot ^ 1;
+}
+
+void LP::Capture::collect(const size_t slot)
+{
+    if (!pbo_pending[slot])
+    {
+        return;
+    }
+
+    pbo_pending[slot] = false;
+
+    Frame frame = {{}, pbo_width[slot], pbo_height[slot], frame_count++};
+
+    {
+        std::lock_guard lock(queue_mtx);
+
+        if (queue.size() >= CAPTURE_QUEUE_MAX)
+        {
+            dropped++;
+            return;
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[slot]);
+
+    const size_t row = static_cast<size_t>(frame.width) * 4;
+
+    if (const auto* data = static_cast<const uint8_t*>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, row * frame.height, GL_MAP_READ_BIT)))
+    {
+        // flip to top to bottom rows while copying
+        frame.pixels.resize(row * frame.height);
+
+        for (int r = 0; r < frame.height; r++)
+        {
+            std::memcpy(frame.pixels.data() + r * row, data + (frame.height - 1 - r) * row, row);
+        }
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (frame.pixels.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(queue_mtx);
+        queue.push_back(std::move(frame));
+    }
+
+    queue_cv.notify_one();
+}
+
+void LP::Capture::write_loop()
+{
+    const std::filesystem::path base = std::filesystem::path(path).replace_extension();
+
+    while (true)
+    {
+        Frame frame;
+
+        {
+            std::unique_lock lock(queue_mtx);
+            queue_cv.wait(lock, []() { return !queue.empty() || !writing; });
+
+            if (queue.empty())
+            {
+                return;
+            }
+
+            frame = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        if (mode == CAPTURE_RAW_VIDEO)
+        {
+            video.write(reinterpret_cast<const char*>(frame.pixels.data()), frame.pixels.size());
+        }
+        else
+        {
+            const std::string file_path = std::format("{}_{:06}.png", base.string(), frame.index);
+
+            if (!write_png(file_path, frame))
+            {
+                std::cerr << "Capture: could not write " << file_path << std::endl;
+            }
+        }
+    }
+}
+
+bool LP::Capture::write_png(const std::string& file_path, const Frame& frame)
+{
+    const size_t row = static_cast<size_t>(frame.width) * 4;
+
+    // every row is prefixed by its filter type, none
+    std::vector<uint8_t> raw((row + 1) * frame.height);
+
+    for (int r = 0; r < frame.height; r++)
+    {
+        raw[r * (row + 1)] = 0;
+        std::memcpy(raw.data() + r * (row + 1) + 1, frame.pixels.data() + r * row, row);
+    }
+
+    uLongf               compressed_size = compressBound(raw.size());
+    std::vector<uint8_t> compressed(compressed_size);
+
+    // fast compression: frames are written at the frame rate
+    if (compress2(compressed.data(), &compressed_size, raw.data(), raw.size(), Z_BEST_SPEED) != Z_OK)
+    {
+        return false;
+    }
+
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    const auto put_u32 = [](std::vector<uint8_t>& out, const uint32_t value)
+    {
+        out.push_back(value >> 24);
+        out.push_back(value >> 16);
+        out.push_back(value >> 8);
+        out.push_back(value);
+    };
+
+    const auto write_chunk = [&file, &put_u32](const char* type, const uint8_t* data, const size_t size)
+    {
+        std::vector<uint8_t> header;
+        put_u32(header, static_cast<uint32_t>(size));
+        header.insert(header.end(), type, type + 4);
+
+        uLong crc = crc32(0, reinterpret_cast<const Bytef*>(type), 4);
+
+        if (size > 0)
+        {
+            crc = crc32(crc, data, static_cast<uInt>(size));
+        }
+
+        std::vector<uint8_t> footer;
+        put_u32(footer, static_cast<uint32_t>(crc));
+
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        file.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+    };
+
+    static constexpr std::array<uint8_t, 8> signature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature.data()), signature.size());
+
+    // width, height, 8 bits per channel, RGBA, deflate, no filter, no interlace
+    std::vector<uint8_t> ihdr;
+    put_u32(ihdr, frame.width);
+    put_u32(ihdr, frame.height);
+    ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0});
+
+    write_chunk("IHDR", ihdr.data(), ihdr.size());
+    write_chunk("IDAT", compressed.data(), compressed_size);
+    write_chunk("IEND", nullptr, 0);
+
+    return file.good();
+}
+
+void LP::Capture::destroy()
+{
+    stop();
+
+    if (pbo[0] != 0)
+    {
+        glDeleteBuffers(2, pbo);
+        pbo[0] = pbo[1] = 0;
+        pbo_size[0] = pbo_size[1] = 0;
+    }
+}
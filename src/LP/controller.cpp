@@ -1,3 +1,4 @@
+#include <LP/capture.h>
 #include <LP/controller.h>
 #include <LP/serial.h>
 #include <LP/shared.h>
@@ -7,8 +8,12 @@
 #include <algorithm>
 #include <chrono>
 #include <exception>
+#include <filesystem>
+#include <format>
+#include <imgui.h>
 #include <iostream>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -18,6 +23,12 @@ LP::app_state_t LP::Controller::curr_app_state(IDLE);
 LP::app_state_t LP::Controller::prev_app_state(IDLE);
 LP::Telemetry   LP::Controller::tel;
 LP::PlotView    LP::Controller::plot_view;
+LP::GeometryPrep LP::Controller::geometry_prep(LP::Controller::tel);
+LP::ExportJob    LP::Controller::export_job;
+LP::ImportJob    LP::Controller::import_job;
+LP::Recorder     LP::Controller::recorder;
+LP::ByteRecorder LP::Controller::byte_recorder;
+LP::ByteReplay   LP::Controller::byte_replay;
 std::mutex      LP::Controller::thread_mtx;
 
 void LP::Controller::update()
@@ -28,17 +39,55 @@ void LP::Controller::update()
     // update toolbar data
     toolbar.update_serial_ports(serial_ports);
 
+    // join the export, import and replay threads once they're done
+    export_job.poll();
+    import_job.poll();
+    byte_replay.poll();
+
+    // a CSV file, or a rotated recording, is framed once it's parsed
+    if (import_job.take_completed())
+    {
+        plot_view.show_limits(import_job.get_overview(plot_view.get_plot_style().time_style));
+    }
+
     Window::render_toolbar(
         [serial_ports]()
         {
-            toolbar.render(curr_app_state, tel.is_empty(), serial_ports);
+            std::optional<JobProgress> job;
+
+            if (export_job.is_running())
+            {
+                job = JobProgress{"Saving...", export_job.get_progress()};
+            }
+            else if (import_job.is_running())
+            {
+                job = JobProgress{"Loading...", import_job.get_progress()};
+            }
+            else if (byte_replay.is_running())
+            {
+                job = JobProgress{"Replaying...", byte_replay.get_progress()};
+            }
+
+            toolbar.render(curr_app_state,
+                           tel.is_empty(),
+                           Capture::is_active(),
+                           recorder.is_active(),
+                           byte_recorder.is_active(),
+                           job,
+                           serial_ports);
             plot_view.render_telemetry(tel);
             plot_view.render_data_format(tel, curr_app_state);
             plot_view.render_plot_options();
         });
 
     const ImVec2 window_size = Window::getWindowSize();
-    plot_view.render_plot(tel, curr_app_state, window_size.x * 0.25, 0, window_size.x * 0.75, window_size.y);
+    // a replay is plotted like a live port
+    const app_state_t plot_state = byte_replay.is_running() ? READING : curr_app_state;
+
+    plot_view.render_plot(
+        tel, geometry_prep, plot_state, window_size.x * 0.25, 0, window_size.x * 0.75, window_size.y);
+
+    Capture::set_region(window_size.x * 0.25, 0, window_size.x * 0.75, window_size.y);
 
     // get updated app state (if we should read or close)
     curr_app_state = toolbar.get_new_app_state(curr_app_state);
@@ -49,6 +98,10 @@ void LP::Controller::update()
     {
         if (curr_app_state == READING)
         {
+            // reading replaces the data being loaded
+            import_job.stop();
+            byte_replay.stop();
+
             start_serial_reading(toolbar.getCurrentPort(), LP::baud_rates[toolbar.getComboboxBaudIndex()].value);
         }
         else
@@ -62,8 +115,64 @@ void LP::Controller::update()
         save_file();
     }
 
+    if (toolbar.getRecordButton())
+    {
+        if (recorder.is_active())
+        {
+            recorder.stop();
+        }
+        else
+        {
+            start_recording();
+        }
+    }
+
+    if (toolbar.getRawRecordButton())
+    {
+        if (byte_recorder.is_active())
+        {
+            byte_recorder.stop();
+        }
+        else
+        {
+            start_raw_recording();
+        }
+    }
+
+    if (toolbar.getSyncChanged())
+    {
+        recorder.set_sync_interval(sync_options[toolbar.getComboboxSyncIndex()].interval_ms);
+    }
+
+    if (toolbar.getOpenButton())
+    {
+        open_file();
+    }
+
+    if (toolbar.getCancelJobButton())
+    {
+        export_job.cancel();
+        import_job.cancel();
+        byte_replay.cancel();
+    }
+
+    if (toolbar.getCaptureFramesButton() || toolbar.getCaptureVideoButton())
+    {
+        if (Capture::is_active())
+        {
+            Capture::stop();
+        }
+        else
+        {
+            start_capture(toolbar.getCaptureVideoButton() ? CAPTURE_RAW_VIDEO : CAPTURE_PNG_FRAMES);
+        }
+    }
+
     if (toolbar.getClearButton())
     {
+        import_job.stop();
+        byte_replay.stop();
+
         std::lock_guard lock(tel.get_data_mtx());
         tel.clear(false);
         tel.set_start_time();
@@ -72,26 +181,133 @@ void LP::Controller::update()
     prev_app_state = curr_app_state;
 }
 
-void LP::Controller::save_file()
+std::string LP::Controller::default_file_name(const std::string& prefix,
+                                              const std::string& suffix,
+                                              const bool         with_device)
 {
-    std::string device_name = Serial::get_last_open_port();
+    std::string file_name = prefix;
+
+    if (with_device)
+    {
+        std::string device_name = Serial::get_last_open_port();
 
 #ifndef _WIN32
-    device_name.erase(0, device_name.find_last_of('/') + 1);
+        device_name.erase(0, device_name.find_last_of('/') + 1);
 #endif
 
-    std::string default_file_name =
-        "lp_" + device_name + "_" + Telemetry::format_datetime(Telemetry::get_unix_time()) + ".csv";
+        file_name += "_" + device_name;
+    }
+
+    file_name += "_" + Telemetry::format_datetime(Telemetry::get_unix_time()) + suffix;
 
     // sanitize default file name (remove ':' from unix timestamp)
-    std::ranges::replace(default_file_name.begin(), default_file_name.end(), ':', '-');
+    std::ranges::replace(file_name.begin(), file_name.end(), ':', '-');
+
+    return file_name;
+}
+
+void LP::Controller::save_file()
+{
+    const std::string path = LP::Window::render_save_fd(
+        default_file_name("lp", ".csv", true).c_str(),
+        {{"CSV File", "csv"},
+         {"Compressed CSV File", "gz"},
+         {"LambdaPlotter capture", "lpcap"},
+         {"Arrow IPC file", "arrow"}});
+
+    if (!path.empty())
+    {
+        // the plot view goes to CSV files, the whole capture to the native and Arrow formats
+        const std::filesystem::path extension = std::filesystem::path(path).extension();
+
+        const ExportFormat format = (extension == ".lpcap")   ? EXPORT_LPCAP
+                                    : (extension == ".arrow") ? EXPORT_ARROW
+                                                              : EXPORT_CSV;
+
+        export_job.start(tel,
+                         path,
+                         format,
+                         plot_view.get_plot_style().limits,
+                         plot_view.get_channels_style(),
+                         plot_view.get_plot_style().time_style);
+    }
+}
+
+void LP::Controller::open_file()
+{
+    const std::string path =
+        LP::Window::render_open_fd(
+            {{"LambdaPlotter capture", "lpcap"},
+             {"CSV File", "csv"},
+             {"Rotated recording", "lpidx"},
+             {"Raw serial capture", "lpraw"}});
+
+    if (path.empty())
+    {
+        return;
+    }
+
+    if (std::filesystem::path(path).extension() == ".lpraw")
+    {
+        byte_replay.start(tel, path, replay_speeds[toolbar.getComboboxReplayIndex()].multiplier);
+    }
+    // frame the whole capture at once, from its index
+    else if (import_job.start(tel, path) && std::filesystem::path(path).extension() == ".lpcap")
+    {
+        plot_view.show_limits(import_job.get_overview(plot_view.get_plot_style().time_style));
+    }
+}
+
+void LP::Controller::start_recording()
+{
+    if (const std::string path = Window::render_save_fd(default_file_name("lp_record", ".csv", true).c_str(),
+                                                        {{"CSV File", "csv"}, {"Compressed CSV File", "gz"}});
+        !path.empty())
+    {
+        const RotationOption& rotation = rotation_options[toolbar.getComboboxRotationIndex()];
+
+        recorder.start(tel,
+                       path,
+                       plot_view.get_plot_style().time_style,
+                       sync_options[toolbar.getComboboxSyncIndex()].interval_ms,
+                       {rotation.max_bytes, rotation.interval_s, static_cast<size_t>(toolbar.getKeepFiles())});
+    }
+}
+
+void LP::Controller::start_raw_recording()
+{
+    if (const std::string path = Window::render_save_fd(default_file_name("lp_raw", ".lpraw", true).c_str(),
+                                                        {{"Raw serial capture", "lpraw"}});
+        !path.empty())
+    {
+        byte_recorder.start(path);
+    }
+}
+
+void LP::Controller::start_capture(const CaptureMode mode)
+{
+    const bool raw = (mode == CAPTURE_RAW_VIDEO);
+
+    std::string suffix = ".png";
+
+    if (raw)
+    {
+        // raw frames have no header, so the size is kept in the name
+        const ImVec2 window_size = Window::getWindowSize();
+        const ImVec2 scale       = ImGui::GetIO().DisplayFramebufferScale;
+
+        suffix = std::format("_{}x{}.rgba",
+                             static_cast<int>(window_size.x * 0.75 * scale.x),
+                             static_cast<int>(window_size.y * scale.y));
+    }
 
-    if (const std::string path = LP::Window::render_save_fd(default_file_name.c_str()); !path.empty())
+    const std::string path =
+        Window::render_save_fd(default_file_name("lp_capture", suffix, false).c_str(),
+                               {raw ? FileFilter{"Raw RGBA video", "rgba"} : FileFilter{"PNG image", "png"}});
+
+    if (!path.empty() && !Capture::start(path, mode))
     {
-        tel.dump_data(path,
-                      plot_view.get_plot_style().limits,
-                      plot_view.get_channels_style(),
-                      plot_view.get_plot_style().time_style);
+        std::cerr << "Could not start the capture to " << path << std::endl;
     }
 }
 
@@ -99,6 +315,15 @@ void LP::Controller::shutdown()
 {
     // set app state to IDLE to make sure to close possible device connections
     curr_app_state = IDLE;
+
+    Capture::stop();
+    recorder.stop();
+    byte_recorder.stop();
+    byte_replay.stop();
+    export_job.stop();
+    import_job.stop();
+    geometry_prep.stop();
+    plot_view.destroy();
 }
 
 void LP::Controller::start_serial_reading(const std::string& port, size_t baud)
@@ -135,11 +360,15 @@ void LP::Controller::start_serial_reading(const std::string& port, size_t baud)
                     // been disconnected.
                     if (std::vector<char> buffer; device.read(buffer))
                     {
+                        byte_recorder.write(buffer, Telemetry::get_unix_time());
 
                         if (std::string frame_stream = tel.parse_serial(buffer); !frame_stream.empty())
                         {
                             std::lock_guard lock(tel.get_data_mtx());
                             tel.parse_frame(frame_stream);
+
+                            // hand the new rows to the recorder's writer
+                            recorder.commit(tel);
                         }
                     }
                     else
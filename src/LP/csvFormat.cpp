@@ -0,0 +1,73 @@
+#include <LP/csvFormat.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+
+void LP::CsvFormatter::append_header(std::string& out, const Snapshot& snapshot)
+{
+    out += "times";
+
+    for (const std::string& name : snapshot.names)
+    {
+        out += ';';
+        out += name;
+    }
+
+    out += '\n';
+}
+
+void LP::CsvFormatter::append_value(std::string& out, const double value)
+{
+    if (std::isnan(value))
+    {
+        return;
+    }
+
+    // enough for the largest double in fixed notation
+    char buffer[400];
+
+    const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+
+    // same digits as std::to_string, with the decimal comma used by the dump format
+    std::replace(buffer, end, '.', ',');
+
+    out.append(buffer, end);
+}
+
+void LP::CsvFormatter::append_time(std::string& out, const double time, const PlotTimeStyle ts)
+{
+    if (ts == DATETIME)
+    {
+        if (const auto second = static_cast<time_t>(time); second != cached_second || cached_datetime.empty())
+        {
+            cached_second   = second;
+            cached_datetime = Telemetry::format_datetime(time);
+        }
+
+        out += cached_datetime;
+        return;
+    }
+
+    char buffer[400];
+
+    const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), time, std::chars_format::fixed, 0);
+
+    out.append(buffer, end);
+}
+
+void LP::CsvFormatter::append_row(std::string& out, const Snapshot& snapshot, const size_t row)
+{
+    append_time(out, snapshot.times[row], snapshot.time_style);
+
+    for (const std::vector<double>& column : snapshot.columns)
+    {
+        out += ';';
+        append_value(out, column[row]);
+    }
+
+    out += '\n';
+}
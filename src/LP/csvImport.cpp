@@ -0,0 +1,582 @@
+#include <LP/csvImport.h>
+#include <LP/gzipWriter.h>
+#include <LP/mappedFile.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+    // end of the line starting at `p`: its '\n', or the end of the file
+    const char* line_end(const char* p, const char* end)
+    {
+        const void* nl = std::memchr(p, '\n', end - p);
+
+        return (nl == nullptr) ? end : static_cast<const char*>(nl);
+    }
+
+    // line from `p` to `eol`, without the '\r' of CRLF files
+    std::string_view make_line(const char* p, const char* eol)
+    {
+        if (eol > p && eol[-1] == '\r')
+            eol--;
+
+        return {p, static_cast<size_t>(eol - p)};
+    }
+
+    // cut the next field off the front of `line`
+    std::string_view next_field(std::string_view& line, const char sep)
+    {
+        const size_t pos = line.find(sep);
+
+        const std::string_view field = line.substr(0, pos);
+        line.remove_prefix((pos == std::string_view::npos) ? line.size() : pos + 1);
+
+        return field;
+    }
+
+    // inflate a gzip file into `out`; a stream cut short, e.g. by a recording still running, gives the text flushed
+    // so far
+    bool inflate_file(const std::string& path, std::string& out)
+    {
+        LP::MappedFile file;
+
+        if (!file.open(path))
+        {
+            return false;
+        }
+
+        z_stream stream = {};
+
+        // 16 more window bits select the gzip wrapper
+        if (inflateInit2(&stream, 15 + 16) != Z_OK)
+        {
+            return false;
+        }
+
+        const char* in      = file.get_data();
+        size_t      in_left = file.get_size();
+        size_t      have    = 0;
+        bool        valid   = true;
+
+        out.resize(std::max<size_t>(file.get_size() * 4, 1 << 16));
+
+        while (true)
+        {
+            // zlib counts in 32 bits, larger files are fed in chunks
+            if (stream.avail_in == 0 && in_left > 0)
+            {
+                const size_t chunk = std::min<size_t>(in_left, UINT_MAX);
+
+                stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+                stream.avail_in = static_cast<uInt>(chunk);
+                in             += chunk;
+                in_left        -= chunk;
+            }
+
+            if (have == out.size())
+            {
+                out.resize(out.size() * 2);
+            }
+
+            const size_t room = std::min<size_t>(out.size() - have, UINT_MAX);
+
+            stream.next_out  = reinterpret_cast<Bytef*>(out.data() + have);
+            stream.avail_out = static_cast<uInt>(room);
+
+            const int ret = inflate(&stream, Z_NO_FLUSH);
+
+            have += room - stream.avail_out;
+
+            const bool input_done = stream.avail_in == 0 && in_left == 0;
+
+            if (ret == Z_STREAM_END)
+            {
+                if (input_done)
+                    break;
+
+                // concatenated gzip members
+                inflateReset(&stream);
+            }
+            else if (ret == Z_BUF_ERROR && input_done)
+            {
+                // no trailer: the end of the written part
+                break;
+            }
+            else if (ret != Z_OK)
+            {
+                valid = false;
+                break;
+            }
+        }
+
+        inflateEnd(&stream);
+        out.resize(have);
+
+        return valid && have > 0;
+    }
+
+    // run `fn(task)` for every task, on a thread per core taking the tasks in turn
+    template <typename F>
+    void for_each_task(const size_t tasks, F&& fn)
+    {
+        std::atomic<size_t> next = 0;
+
+        const auto work = [&]()
+        {
+            for (size_t task = next++; task < tasks; task = next++)
+            {
+                fn(task);
+            }
+        };
+
+        const size_t threads_count = std::min<size_t>(tasks, std::max(1u, std::thread::hardware_concurrency()));
+
+        std::vector<std::thread> threads;
+
+        for (size_t t = 1; t < threads_count; t++)
+        {
+            threads.emplace_back(work);
+        }
+
+        work();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+double LP::CsvImport::parse_time(std::string_view field, const bool datetime)
+{
+    if (!datetime)
+    {
+        double value = NAN;
+
+        if (std::from_chars(field.data(), field.data() + field.size(), value).ec != std::errc())
+        {
+            return NAN;
+        }
+
+        return value;
+    }
+
+    // "%Y-%m-%d_%H:%M:%S", as written by the dump
+    int        parts[6];
+    const char seps[6] = {'-', '-', '_', ':', ':', '\0'};
+
+    const char* p   = field.data();
+    const char* end = field.data() + field.size();
+
+    for (int i = 0; i < 6; i++)
+    {
+        const auto [next, ec] = std::from_chars(p, end, parts[i]);
+
+        if (ec != std::errc() || (i < 5 && (next == end || *next != seps[i])))
+        {
+            return NAN;
+        }
+
+        p = next + 1;
+    }
+
+    std::tm tm  = {};
+    tm.tm_year  = parts[0] - 1900;
+    tm.tm_mon   = parts[1] - 1;
+    tm.tm_mday  = parts[2];
+    tm.tm_hour  = parts[3];
+    tm.tm_min   = parts[4];
+    tm.tm_sec   = parts[5];
+    tm.tm_isdst = -1;
+
+    // the dump writes local times
+    const time_t time = std::mktime(&tm);
+
+    return (time == -1) ? NAN : static_cast<double>(time);
+}
+
+double LP::CsvImport::parse_value(std::string_view field, const char decimal)
+{
+    while (!field.empty() && field.front() == ' ')
+        field.remove_prefix(1);
+
+    if (field.empty())
+    {
+        return NAN;
+    }
+
+    double value = NAN;
+
+    if (decimal == '.')
+    {
+        if (std::from_chars(field.data(), field.data() + field.size(), value).ec != std::errc())
+            return NAN;
+
+        return value;
+    }
+
+    // from_chars only knows the '.' decimal point
+    char buffer[64];
+
+    if (field.size() > sizeof(buffer))
+    {
+        return NAN;
+    }
+
+    std::replace_copy(field.begin(), field.end(), buffer, decimal, '.');
+
+    if (std::from_chars(buffer, buffer + field.size(), value).ec != std::errc())
+    {
+        return NAN;
+    }
+
+    return value;
+}
+
+LP::CsvImport::Dialect LP::CsvImport::detect(const std::string_view first_line, const std::string_view second_line)
+{
+    Dialect dialect{};
+
+    // the dump uses ';' separators and ',' decimals
+    if (first_line.find(';') != std::string_view::npos || first_line.find(',') == std::string_view::npos)
+    {
+        dialect.sep     = ';';
+        dialect.decimal = ',';
+    }
+    else
+    {
+        dialect.sep     = ',';
+        dialect.decimal = '.';
+    }
+
+    const auto is_datetime = [](const std::string_view field)
+    { return field.find('_') != std::string_view::npos || field.find(':') != std::string_view::npos; };
+
+    std::string_view line  = first_line;
+    std::string_view field = next_field(line, dialect.sep);
+
+    // a first field that isn't a time is the times column's name
+    dialect.header = std::isnan(parse_time(field, is_datetime(field)));
+
+    if (dialect.header)
+    {
+        line  = second_line;
+        field = next_field(line, dialect.sep);
+    }
+
+    dialect.datetime = is_datetime(field);
+
+    return dialect;
+}
+
+bool LP::CsvImport::load(const std::string&       path,
+                         Telemetry&               tel,
+                         std::atomic<size_t>*     progress,
+                         const std::atomic<bool>* cancel)
+{
+    return load(std::vector<std::string>{path}, tel, progress, cancel);
+}
+
+bool LP::CsvImport::load(const std::vector<std::string>& paths,
+                         Telemetry&                      tel,
+                         std::atomic<size_t>*            progress,
+                         const std::atomic<bool>*        cancel)
+{
+    if (paths.empty())
+    {
+        return false;
+    }
+
+    // every file is mapped, or inflated on a thread per core, and split on its own; the first one sets the columns
+    std::vector<Source> sources(paths.size());
+    std::vector<char>   opened(paths.size(), false);
+
+    for_each_task(paths.size(),
+                  [&](const size_t f)
+                  {
+                      Source& source = sources[f];
+
+                      source.compressed = GzipWriter::is_gzip_path(paths[f]);
+
+                      if (source.compressed)
+                      {
+                          opened[f]   = inflate_file(paths[f], source.inflated);
+                          source.text = source.inflated;
+                      }
+                      else
+                      {
+                          opened[f]   = source.file.open(paths[f]);
+                          source.text = {source.file.get_data(), source.file.get_size()};
+                      }
+                  });
+
+    if (std::ranges::find(opened, false) != opened.end())
+    {
+        return false;
+    }
+
+    size_t                           columns = 0;
+    std::unordered_map<int, Channel> channels;
+
+    for (size_t f = 0; f < paths.size(); f++)
+    {
+        Source& source = sources[f];
+
+        const char* begin = source.text.data();
+        const char* end   = begin + source.text.size();
+
+        // skip the UTF-8 byte order mark
+        if (end - begin >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+        {
+            begin += 3;
+        }
+
+        const char*            first_end   = line_end(begin, end);
+        const char*            second      = (first_end == end) ? end : first_end + 1;
+        const std::string_view first_line  = make_line(begin, first_end);
+        const std::string_view second_line = make_line(second, line_end(second, end));
+
+        source.dialect = detect(first_line, second_line);
+
+        if (f == 0)
+        {
+            // every field after the times is a channel
+            columns = std::count(first_line.begin(), first_line.end(), source.dialect.sep);
+
+            std::string_view header = first_line;
+            next_field(header, source.dialect.sep);
+
+            for (size_t c = 0; c < columns; c++)
+            {
+                const std::string_view name = next_field(header, source.dialect.sep);
+
+                // numbered from 1, as the channels of a serial capture
+                Channel& channel = channels[static_cast<int>(c + 1)];
+                channel.name =
+                    (source.dialect.header && !name.empty()) ? std::string(name) : std::format("Data {}", c + 1);
+                channel.scale  = 1.0;
+                channel.offset = 0.0;
+            }
+        }
+
+        const char* data_begin = source.dialect.header ? second : begin;
+
+        // the progress counts the bytes of the files: a compressed one is done once inflated
+        if (progress != nullptr)
+        {
+            std::error_code ec;
+            *progress += source.compressed ? std::filesystem::file_size(paths[f], ec) : data_begin - source.text.data();
+        }
+
+        // split at row boundaries: every block holds the lines starting inside of it
+        const size_t data_size = end - data_begin;
+        const size_t blocks    = std::clamp<size_t>(
+            data_size / CSV_IMPORT_MIN_BLOCK, 1, std::max(1u, std::thread::hardware_concurrency()));
+
+        source.bounds = {data_begin};
+
+        for (size_t b = 1; b < blocks; b++)
+        {
+            const char* p = std::max(data_begin + data_size * b / blocks, source.bounds.back());
+
+            p = line_end(p, end);
+            source.bounds.push_back((p == end) ? end : p + 1);
+        }
+
+        source.bounds.push_back(end);
+    }
+
+    // the blocks of all the files, in order
+    std::vector<std::pair<size_t, size_t>> tasks;
+
+    for (size_t f = 0; f < sources.size(); f++)
+    {
+        for (size_t b = 0; b + 1 < sources[f].bounds.size(); b++)
+        {
+            tasks.emplace_back(f, b);
+        }
+    }
+
+    // first pass: count the rows of every block, blank lines aren't rows
+    std::vector<size_t> block_rows(tasks.size(), 0);
+
+    for_each_task(tasks.size(),
+                  [&](const size_t t)
+                  {
+                      const auto& [f, b] = tasks[t];
+                      const char* end    = sources[f].bounds.back();
+
+                      for (const char* p = sources[f].bounds[b]; p < sources[f].bounds[b + 1];)
+                      {
+                          const char* eol = line_end(p, end);
+
+                          if (!make_line(p, eol).empty())
+                              block_rows[t]++;
+
+                          p = (eol == end) ? end : eol + 1;
+                      }
+                  });
+
+    std::vector<size_t> first_row(tasks.size() + 1, 0);
+
+    for (size_t t = 0; t < tasks.size(); t++)
+    {
+        first_row[t + 1] = first_row[t] + block_rows[t];
+    }
+
+    const size_t rows = first_row.back();
+
+    std::vector<double>  times(rows);
+    std::vector<double*> values(columns);
+
+    for (size_t c = 0; c < columns; c++)
+    {
+        std::vector<double>& column = channels[static_cast<int>(c + 1)].values;
+
+        column.resize(rows);
+        values[c] = column.data();
+    }
+
+    // second pass: parse every block straight into its rows of the columns
+    std::atomic<bool> aborted = false;
+
+    for_each_task(tasks.size(),
+                  [&](const size_t t)
+                  {
+                      const auto& [f, b] = tasks[t];
+
+                      const Dialect& dialect    = sources[f].dialect;
+                      const bool     counted    = progress != nullptr && !sources[f].compressed;
+                      const char*    file_end   = sources[f].bounds.back();
+                      const char*    end        = sources[f].bounds[b + 1];
+                      const char*    reported   = sources[f].bounds[b];
+                      size_t         row        = first_row[t];
+                      size_t         since_last = 0;
+
+                      // datetimes change once a second, the last one is reused for the rows in between
+                      std::string_view last_field;
+                      double           last_time = NAN;
+
+                      for (const char* p = sources[f].bounds[b]; p < end;)
+                      {
+                          const char*      eol  = line_end(p, file_end);
+                          std::string_view line = make_line(p, eol);
+
+                          p = (eol == file_end) ? file_end : eol + 1;
+
+                          if (line.empty())
+                              continue;
+
+                          const std::string_view time_field = next_field(line, dialect.sep);
+
+                          if (time_field != last_field)
+                          {
+                              last_field = time_field;
+                              last_time  = parse_time(time_field, dialect.datetime);
+                          }
+
+                          times[row] = last_time;
+
+                          for (size_t c = 0; c < columns; c++)
+                          {
+                              values[c][row] =
+                                  line.empty() ? NAN : parse_value(next_field(line, dialect.sep), dialect.decimal);
+                          }
+
+                          row++;
+
+                          if (++since_last == CSV_IMPORT_CHECK_ROWS)
+                          {
+                              since_last = 0;
+
+                              if (counted)
+                              {
+                                  *progress += p - reported;
+                                  reported   = p;
+                              }
+
+                              if ((cancel != nullptr && *cancel) || aborted)
+                              {
+                                  aborted = true;
+                                  return;
+                              }
+                          }
+                      }
+
+                      if (counted)
+                      {
+                          *progress += end - reported;
+                      }
+                  });
+
+    if (aborted || (cancel != nullptr && *cancel))
+    {
+        return false;
+    }
+    // rows with an invalid time take the previous one, leading ones the first valid one
+    const auto first_valid = std::ranges::find_if(times, [](const double t) { return !std::isnan(t); });
+    double     last_valid  = (first_valid == times.end()) ? 0.0 : *first_valid;
+
+    for (double& time : times)
+    {
+        if (std::isnan(time))
+            time = last_valid;
+        else
+            last_valid = time;
+    }
+
+    std::vector<double> times_unix(rows);
+    std::vector<double> times_elapsed(rows);
+
+    if (sources.front().dialect.datetime)
+    {
+        for (size_t i = 0; i < rows; i++)
+        {
+            times_unix[i]    = times[i];
+            times_elapsed[i] = (times[i] - times.front()) * 1000.0;
+        }
+    }
+    else
+    {
+        // elapsed dumps don't hold the date: the last row is taken as written when the last file was last modified
+        std::error_code ec;
+        const auto      modified = std::filesystem::last_write_time(paths.back(), ec);
+
+        const double modified_unix =
+            ec ? Telemetry::get_unix_time()
+               : std::chrono::duration<double>(
+                     std::chrono::file_clock::to_sys(modified).time_since_epoch()).count();
+
+        for (size_t i = 0; i < rows; i++)
+        {
+            times_unix[i]    = modified_unix - (times.back() - times[i]) / 1000.0;
+            times_elapsed[i] = times[i];
+        }
+    }
+
+    for (Channel& channel : channels | std::views::values)
+    {
+        Telemetry::index_channel(channel);
+    }
+
+    std::lock_guard lock(tel.get_data_mtx());
+    tel.replace_data(std::move(times_unix), std::move(times_elapsed), std::move(channels));
+
+    return true;
+}
@@ -0,0 +1,115 @@
+#include <LP/arrowFile.h>
+#include <LP/exportJob.h>
+#include <LP/lpcap.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "LP/plotView.h"
+
+LP::ExportJob::~ExportJob()
+{
+    stop();
+}
+
+bool LP::ExportJob::start(const Telemetry&                      tel,
+                          const std::string&                    file_path,
+                          const ExportFormat                    file_format,
+                          const Limits                          limits,
+                          std::unordered_map<int, ChannelStyle> ch_styles,
+                          const PlotTimeStyle                   ts)
+{
+    poll();
+
+    if (state == EXPORT_RUNNING)
+    {
+        return false;
+    }
+
+    path       = file_path;
+    format     = file_format;
+    cancelled  = false;
+    rows_done  = 0;
+    rows_total = 0;
+    state      = EXPORT_RUNNING;
+
+    worker = std::thread(&ExportJob::run, this, std::cref(tel), limits, std::move(ch_styles), ts);
+
+    return true;
+}
+
+void LP::ExportJob::run(const Telemetry&                      tel,
+                        const Limits                          limits,
+                        std::unordered_map<int, ChannelStyle> ch_styles,
+                        const PlotTimeStyle                   ts)
+{
+    bool done;
+
+    if (format == EXPORT_LPCAP || format == EXPORT_ARROW)
+    {
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+            rows_total = tel.get_unix_timestamps()->size();
+        }
+
+        done = (format == EXPORT_LPCAP) ? LpCapFile::save(path, tel, &rows_done, &cancelled)
+                                        : ArrowFile::save(path, tel, &rows_done, &cancelled);
+    }
+    else
+    {
+        const Snapshot snapshot = tel.snapshot(limits, ch_styles, ts);
+
+        rows_total = snapshot.times.size();
+
+        done = Telemetry::write_csv(path, snapshot, &rows_done, &cancelled);
+    }
+
+    if (done)
+    {
+        state = EXPORT_DONE;
+        return;
+    }
+
+    // don't leave a truncated file behind
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    state = cancelled ? EXPORT_CANCELLED : EXPORT_FAILED;
+
+    if (state == EXPORT_CANCELLED)
+    {
+        std::cout << "Dump cancelled." << std::endl;
+    }
+}
+
+void LP::ExportJob::poll()
+{
+    if (state != EXPORT_RUNNING && worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void LP::ExportJob::stop()
+{
+    cancelled = true;
+
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+float LP::ExportJob::get_progress() const
+{
+    const size_t total = rows_total;
+
+    return (total == 0) ? 0.0f : std::min(1.0f, static_cast<float>(rows_done) / static_cast<float>(total));
+}
@@ -0,0 +1,71 @@
+#include <LP/fft.h>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+void LP::FFT::transform(std::vector<std::complex<double>>& data)
+{
+    const size_t n = data.size();
+
+    // bit reversal permutation
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+
+        j ^= bit;
+
+        if (i < j)
+        {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const double               angle = -2.0 * std::numbers::pi / len;
+        const std::complex<double> step(std::cos(angle), std::sin(angle));
+
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> w(1.0, 0.0);
+
+            for (size_t k = 0; k < len / 2; k++)
+            {
+                const std::complex<double> even = data[i + k];
+                const std::complex<double> odd  = data[i + k + len / 2] * w;
+
+                data[i + k]           = even + odd;
+                data[i + k + len / 2] = even - odd;
+
+                w *= step;
+            }
+        }
+    }
+}
+
+void LP::FFT::power_db(const double* samples, const size_t n, float* out, std::vector<std::complex<double>>& work)
+{
+    work.resize(n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const double hann = 0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * i / (n - 1));
+
+        work[i] = std::isnan(samples[i]) ? 0.0 : samples[i] * hann;
+    }
+
+    transform(work);
+
+    for (size_t k = 0; k < n / 2; k++)
+    {
+        // floor at -200 dB, so that silent bins don't map to -inf
+        out[k] = static_cast<float>(10.0 * std::log10(std::norm(work[k]) / n + 1e-20));
+    }
+}
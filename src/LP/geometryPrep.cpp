@@ -0,0 +1,243 @@
+#include <LP/geometryPrep.h>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+bool LP::PreparedFrame::covers(const double x_min, const double x_max, const PlotTimeStyle ts) const
+{
+    const double span = request.x_max - request.x_min;
+
+    return request.time_style == ts && request.width > 0 && x_min >= request.x_min - span * PREP_MARGIN &&
+           x_max <= request.x_max + span * PREP_MARGIN;
+}
+
+LP::GeometryPrep::~GeometryPrep()
+{
+    stop();
+}
+
+void LP::GeometryPrep::post(const PrepRequest& req, const size_t samples)
+{
+    std::lock_guard lock(request_mtx);
+
+    if (!running)
+    {
+        running = true;
+        worker  = std::thread(&GeometryPrep::run, this);
+    }
+
+    // nothing changed since the last request, the prepared points are still valid
+    if (req == request && samples == request_samples)
+    {
+        return;
+    }
+
+    request         = req;
+    request_samples = samples;
+    pending         = true;
+
+    request_cv.notify_one();
+}
+
+void LP::GeometryPrep::stop()
+{
+    {
+        std::lock_guard lock(request_mtx);
+
+        if (!running)
+        {
+            return;
+        }
+
+        running = false;
+    }
+
+    request_cv.notify_one();
+
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void LP::GeometryPrep::run()
+{
+    while (true)
+    {
+        PrepRequest req;
+
+        {
+            std::unique_lock lock(request_mtx);
+            request_cv.wait(lock, [this]() { return pending || !running; });
+
+            if (!running)
+            {
+                return;
+            }
+
+            req     = request;
+            pending = false;
+        }
+
+        prepare(req);
+
+        // publish the new points, the UI picks them up on its next frame
+        std::lock_guard lock(front_mtx);
+        std::swap(front, back);
+    }
+}
+
+void LP::GeometryPrep::prepare(const PrepRequest& req)
+{
+    back.request = req;
+
+    const double span    = req.x_max - req.x_min;
+    const double x_min   = req.x_min - span * PREP_MARGIN;
+    const double x_max   = req.x_max + span * PREP_MARGIN;
+    const bool   visible = req.width > 0 && req.x_max > req.x_min;
+
+    size_t used = 0;
+
+    // copy the visible samples under the lock, the decimation runs without it so that neither the UI nor the reading
+    // thread wait for it
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        const std::vector<double>& times =
+            (req.time_style == DATETIME) ? *tel.get_unix_timestamps() : *tel.get_elapsed_timestamps();
+        auto* data = tel.get_data();
+
+        back.samples = times.size();
+
+        for (const PrepChannel& ch : req.channels)
+        {
+            const auto it = data->find(ch.ch_id);
+
+            if (!visible || it == data->end())
+                continue;
+
+            const std::vector<double>& values = it->second.values;
+            const size_t               n      = std::min(values.size(), times.size());
+
+            // one sample past each side, so that the line reaches the plot borders
+            size_t first = std::lower_bound(times.begin(), times.begin() + n, x_min) - times.begin();
+            size_t last  = std::upper_bound(times.begin() + first, times.begin() + n, x_max) - times.begin();
+
+            first = (first > 0) ? first - 1 : 0;
+            last  = std::min(last + 1, n);
+
+            if (used == slices.size())
+                slices.emplace_back();
+
+            PrepSlice& slice = slices[used++];
+
+            slice.ch_id  = ch.ch_id;
+            slice.scale  = ch.scale;
+            slice.offset = ch.offset;
+            slice.times.assign(times.begin() + first, times.begin() + last);
+            slice.values.assign(values.begin() + first, values.begin() + last);
+        }
+    }
+
+    // keep the buffers of the channels still prepared, so that their memory is reused
+    std::erase_if(back.channels,
+                  [this, used](const auto& entry)
+                  {
+                      return std::none_of(slices.begin(),
+                                          slices.begin() + used,
+                                          [&entry](const PrepSlice& slice) { return slice.ch_id == entry.first; });
+                  });
+
+    if (!visible)
+    {
+        return;
+    }
+
+    const size_t columns = static_cast<size_t>(req.width * (1.0 + 2.0 * PREP_MARGIN));
+    const double dx      = (x_max - x_min) / columns;
+
+    for (size_t s = 0; s < used; s++)
+    {
+        const PrepSlice& slice = slices[s];
+        PreparedChannel& out   = back.channels[slice.ch_id];
+        const size_t     count = slice.times.size();
+
+        if (count <= 2 * columns)
+        {
+            out.xs = slice.times;
+            out.ys.resize(count);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                out.ys[i] = slice.values[i] * slice.scale + slice.offset;
+            }
+        }
+        else
+        {
+            decimate(slice.times, slice.values, 0, count, slice.scale, slice.offset, dx, out);
+        }
+    }
+}
+
+void LP::GeometryPrep::decimate(const std::vector<double>& times,
+                                const std::vector<double>& values,
+                                const size_t               first,
+                                const size_t               last,
+                                const double               scale,
+                                const double               offset,
+                                const double               dx,
+                                PreparedChannel&           out)
+{
+    out.xs.clear();
+    out.ys.clear();
+
+    size_t i = first;
+
+    while (i < last)
+    {
+        // columns are aligned to multiples of `dx`, so that they don't shift while the view scrolls
+        const double column_end = (std::floor(times[i] / dx) + 1.0) * dx;
+
+        size_t min_i = last;
+        size_t max_i = last;
+        size_t j     = i;
+
+        for (; j < last && (j == i || times[j] < column_end); j++)
+        {
+            if (std::isnan(values[j]))
+                continue;
+
+            if (min_i == last || values[j] < values[min_i])
+                min_i = j;
+
+            if (max_i == last || values[j] > values[max_i])
+                max_i = j;
+        }
+
+        if (min_i == last)
+        {
+            out.xs.push_back(times[i]);
+            out.ys.push_back(NAN);
+        }
+        else
+        {
+            // keep the time order, so that the points stay sorted by X
+            const size_t a = std::min(min_i, max_i);
+            const size_t b = std::max(min_i, max_i);
+
+            out.xs.push_back(times[a]);
+            out.ys.push_back(values[a] * scale + offset);
+
+            if (b != a)
+            {
+                out.xs.push_back(times[b]);
+                out.ys.push_back(values[b] * scale + offset);
+            }
+        }
+
+        i = j;
+    }
+}
@@ -0,0 +1,606 @@
+#include <LP/gpuPlot.h>
+#include <cmath>
+#include <cstdio>
+#include <glad/glad.h>
+#include <imgui.h>
+#include <string>
+#include <vector>
+
+#include "../implot/implot.h"
+#include "../implot/implot_internal.h"
+
+struct LP::GpuPlot::Batch {
+    // vertices relative to the plot limits minimum, so that they fit in floats even for unix timestamps
+    std::vector<float> vertices;
+
+    // strips of consecutive valid points, split at NaNs
+    std::vector<GLint>   strip_first;
+    std::vector<GLsizei> strip_count;
+
+    // plot to pixel transform: scale x, scale y, offset x, offset y
+    float transform[4];
+
+    // line or marker outline color
+    float color[4];
+
+    // markers style
+    float fill_color[4];
+    float size;
+    int   marker;
+    bool  render_fill;
+    bool  render_line;
+};
+
+std::vector<LP::GpuPlot::Batch> LP::GpuPlot::batches;
+size_t                          LP::GpuPlot::batch_count = 0;
+
+bool         LP::GpuPlot::available      = false;
+bool         LP::GpuPlot::instancing     = false;
+unsigned int LP::GpuPlot::line_program   = 0;
+unsigned int LP::GpuPlot::marker_program = 0;
+unsigned int LP::GpuPlot::vao            = 0;
+unsigned int LP::GpuPlot::marker_vao     = 0;
+unsigned int LP::GpuPlot::vbo            = 0;
+unsigned int LP::GpuPlot::mesh_vbo       = 0;
+
+int LP::GpuPlot::line_loc_proj      = -1;
+int LP::GpuPlot::line_loc_transform = -1;
+int LP::GpuPlot::line_loc_color     = -1;
+
+int LP::GpuPlot::marker_loc_proj      = -1;
+int LP::GpuPlot::marker_loc_transform = -1;
+int LP::GpuPlot::marker_loc_color     = -1;
+int LP::GpuPlot::marker_loc_size      = -1;
+
+static std::string glsl_header;
+
+// ranges of the markers mesh, indexed by ImPlotMarker
+typedef struct MarkerMesh {
+    GLint   fill_first = 0;
+    GLsizei fill_count = 0;
+    GLint   line_first = 0;
+    GLsizei line_count = 0;
+    GLenum  line_mode  = GL_LINE_LOOP;
+} MarkerMesh;
+
+static MarkerMesh marker_meshes[ImPlotMarker_COUNT];
+
+static const char* line_vertex_src = R"(
+uniform mat4 ProjMtx;
+uniform vec4 Transform;
+in vec2 Position;
+void main()
+{
+    gl_Position = ProjMtx * vec4(Position * Transform.xy + Transform.zw, 0.0, 1.0);
+}
+)";
+
+static const char* marker_vertex_src = R"(
+uniform mat4 ProjMtx;
+uniform vec4 Transform;
+uniform float Size;
+in vec2 Position;
+in vec2 Offset;
+void main()
+{
+    gl_Position = ProjMtx * vec4(Offset * Transform.xy + Transform.zw + Position * Size, 0.0, 1.0);
+}
+)";
+
+static const char* line_fragment_src = R"(
+uniform vec4 Color;
+out vec4 Out_Color;
+void main()
+{
+    Out_Color = Color;
+}
+)";
+
+/**
+ * @brief Read the value at index `i` of a strided array
+ */
+static double index_data(const double* data, const int i, const int stride)
+{
+    return *reinterpret_cast<const double*>(reinterpret_cast<const unsigned char*>(data) +
+                                            static_cast<size_t>(i) * stride);
+}
+
+/**
+ * @brief Binary search the first index in [lo, hi) for which `pred` is false, `pred` being partitioned
+ */
+template <typename Pred> static int partition_index(int lo, int hi, Pred pred)
+{
+    while (lo < hi)
+    {
+        const int mid = lo + (hi - lo) / 2;
+
+        if (pred(mid))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+bool LP::GpuPlot::init(const char* glsl_version)
+{
+    int version = 0;
+    std::sscanf(glsl_version, "#version %d", &version);
+
+    // the shaders use `in`/`out` qualifiers, which GLSL 100 (OpenGL ES 2) doesn't have
+    if (version < 130 || !GLAD_GL_VERSION_3_0)
+    {
+        available = false;
+        return false;
+    }
+
+    glsl_header = std::string(glsl_version) + "\n";
+
+    if (std::string(glsl_version).find(" es") != std::string::npos)
+    {
+        glsl_header += "precision mediump float;\n";
+    }
+
+    line_program = create_program(line_vertex_src, line_fragment_src);
+
+    if (line_program == 0)
+    {
+        available = false;
+        return false;
+    }
+
+    line_loc_proj      = glGetUniformLocation(line_program, "ProjMtx");
+    line_loc_transform = glGetUniformLocation(line_program, "Transform");
+    line_loc_color     = glGetUniformLocation(line_program, "Color");
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    available = true;
+
+    // glVertexAttribDivisor is core since 3.3, without it scatter plots fall back to ImPlot
+    if (GLAD_GL_VERSION_3_3)
+    {
+        marker_program = create_program(marker_vertex_src, line_fragment_src);
+
+        if (marker_program != 0)
+        {
+            init_markers();
+            instancing = true;
+        }
+    }
+
+    return true;
+}
+
+void LP::GpuPlot::init_markers()
+{
+    marker_loc_proj      = glGetUniformLocation(marker_program, "ProjMtx");
+    marker_loc_transform = glGetUniformLocation(marker_program, "Transform");
+    marker_loc_color     = glGetUniformLocation(marker_program, "Color");
+    marker_loc_size      = glGetUniformLocation(marker_program, "Size");
+
+    constexpr float SQRT_1_2 = 0.70710678118f;
+    constexpr float SQRT_3_2 = 0.86602540378f;
+
+    std::vector<ImVec2> mesh;
+
+    // convex markers, same shapes as ImPlot: filled as a triangle fan and outlined as a line loop
+    auto add_polygon = [&](const ImPlotMarker marker, const std::vector<ImVec2>& points) {
+        marker_meshes[marker].fill_first = marker_meshes[marker].line_first = static_cast<GLint>(mesh.size());
+        marker_meshes[marker].fill_count = marker_meshes[marker].line_count = static_cast<GLsizei>(points.size());
+        mesh.insert(mesh.end(), points.begin(), points.end());
+    };
+
+    // markers that can't be filled, drawn as separate segments
+    auto add_segments = [&](const ImPlotMarker marker, const std::vector<ImVec2>& points) {
+        marker_meshes[marker].line_first = static_cast<GLint>(mesh.size());
+        marker_meshes[marker].line_count = static_cast<GLsizei>(points.size());
+        marker_meshes[marker].line_mode  = GL_LINES;
+        mesh.insert(mesh.end(), points.begin(), points.end());
+    };
+
+    std::vector<ImVec2> circle;
+    for (int i = 0; i < 10; i++)
+    {
+        circle.emplace_back(ImCos(i * IM_PI / 5), ImSin(i * IM_PI / 5));
+    }
+
+    add_polygon(ImPlotMarker_Circle, circle);
+    add_polygon(ImPlotMarker_Square,
+                {{SQRT_1_2, SQRT_1_2}, {SQRT_1_2, -SQRT_1_2}, {-SQRT_1_2, -SQRT_1_2}, {-SQRT_1_2, SQRT_1_2}});
+    add_polygon(ImPlotMarker_Diamond, {{1, 0}, {0, -1}, {-1, 0}, {0, 1}});
+    add_polygon(ImPlotMarker_Up, {{SQRT_3_2, 0.5f}, {0, -1}, {-SQRT_3_2, 0.5f}});
+    add_polygon(ImPlotMarker_Down, {{SQRT_3_2, -0.5f}, {0, 1}, {-SQRT_3_2, -0.5f}});
+    add_polygon(ImPlotMarker_Left, {{-1, 0}, {0.5f, SQRT_3_2}, {0.5f, -SQRT_3_2}});
+    add_polygon(ImPlotMarker_Right, {{1, 0}, {-0.5f, SQRT_3_2}, {-0.5f, -SQRT_3_2}});
+    add_segments(ImPlotMarker_Cross,
+                 {{-SQRT_1_2, -SQRT_1_2}, {SQRT_1_2, SQRT_1_2}, {SQRT_1_2, -SQRT_1_2}, {-SQRT_1_2, SQRT_1_2}});
+    add_segments(ImPlotMarker_Plus, {{-1, 0}, {1, 0}, {0, -1}, {0, 1}});
+    add_segments(ImPlotMarker_Asterisk,
+                 {{-SQRT_3_2, -0.5f}, {SQRT_3_2, 0.5f}, {-SQRT_3_2, 0.5f}, {SQRT_3_2, -0.5f}, {0, -1}, {0, 1}});
+
+    glGenVertexArrays(1, &marker_vao);
+    glGenBuffers(1, &mesh_vbo);
+
+    glBindVertexArray(marker_vao);
+
+    // attribute 0: mesh vertex, the same for every instance
+    glBindBuffer(GL_ARRAY_BUFFER, mesh_vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mesh.size() * sizeof(ImVec2)), mesh.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImVec2), nullptr);
+
+    // attribute 1: point position, advancing once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    glVertexAttribDivisor(1, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void LP::GpuPlot::new_frame()
+{
+    batch_count = 0;
+}
+
+void LP::GpuPlot::destroy()
+{
+    if (!available)
+        return;
+
+    if (instancing)
+    {
+        glDeleteProgram(marker_program);
+        glDeleteBuffers(1, &mesh_vbo);
+        glDeleteVertexArrays(1, &marker_vao);
+    }
+
+    glDeleteProgram(line_program);
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+
+    batches.clear();
+    batch_count = 0;
+    available   = false;
+    instancing  = false;
+}
+
+unsigned int LP::GpuPlot::create_program(const char* vertex_src, const char* fragment_src)
+{
+    const char* vertex_sources[2]   = {glsl_header.c_str(), vertex_src};
+    const char* fragment_sources[2] = {glsl_header.c_str(), fragment_src};
+
+    const GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex_shader, 2, vertex_sources, nullptr);
+    glCompileShader(vertex_shader);
+
+    const GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragment_shader, 2, fragment_sources, nullptr);
+    glCompileShader(fragment_shader);
+
+    const GLuint program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+
+    // the vertex position always sits at location 0
+    glBindAttribLocation(program, 0, "Position");
+    // per-instance attributes come after the per-vertex ones
+    glBindAttribLocation(program, 1, "Offset");
+    glLinkProgram(program);
+
+    glDetachShader(program, vertex_shader);
+    glDetachShader(program, fragment_shader);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (status != GL_TRUE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+LP::GpuPlot::Batch& LP::GpuPlot::next_batch()
+{
+    if (batch_count == batches.size())
+    {
+        batches.emplace_back();
+    }
+
+    Batch& batch = batches[batch_count++];
+
+    batch.vertices.clear();
+    batch.strip_first.clear();
+    batch.strip_count.clear();
+
+    return batch;
+}
+
+void LP::GpuPlot::setup_render_state(const ImDrawCmd* cmd, const int loc_proj)
+{
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+
+    const ImVec2 pos      = draw_data->DisplayPos;
+    const ImVec2 size     = draw_data->DisplaySize;
+    const ImVec2 fb_scale = draw_data->FramebufferScale;
+
+    // the backend only sets the scissor rect for its own draw commands
+    const ImVec2 clip_min((cmd->ClipRect.x - pos.x) * fb_scale.x, (cmd->ClipRect.y - pos.y) * fb_scale.y);
+    const ImVec2 clip_max((cmd->ClipRect.z - pos.x) * fb_scale.x, (cmd->ClipRect.w - pos.y) * fb_scale.y);
+
+    glScissor(static_cast<GLint>(clip_min.x),
+              static_cast<GLint>(size.y * fb_scale.y - clip_max.y),
+              static_cast<GLsizei>(clip_max.x - clip_min.x),
+              static_cast<GLsizei>(clip_max.y - clip_min.y));
+
+    // same orthographic projection used by the ImGui backend
+    const float L = pos.x;
+    const float R = pos.x + size.x;
+    const float T = pos.y;
+    const float B = pos.y + size.y;
+
+    const float ortho_projection[4][4] = {
+        {2.0f / (R - L), 0.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f / (T - B), 0.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 0.0f},
+        {(R + L) / (L - R), (T + B) / (B - T), 0.0f, 1.0f},
+    };
+
+    glUniformMatrix4fv(loc_proj, 1, GL_FALSE, &ortho_projection[0][0]);
+}
+
+void LP::GpuPlot::render_line(const ImDrawList*, const ImDrawCmd* cmd)
+{
+    const Batch& batch = batches[*static_cast<const size_t*>(cmd->UserCallbackData)];
+
+    glUseProgram(line_program);
+    setup_render_state(cmd, line_loc_proj);
+
+    glUniform4fv(line_loc_transform, 1, batch.transform);
+    glUniform4fv(line_loc_color, 1, batch.color);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(batch.vertices.size() * sizeof(float)),
+                 batch.vertices.data(),
+                 GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    glMultiDrawArrays(GL_LINE_STRIP,
+                      batch.strip_first.data(),
+                      batch.strip_count.data(),
+                      static_cast<GLsizei>(batch.strip_first.size()));
+}
+
+void LP::GpuPlot::render_markers(const ImDrawList*, const ImDrawCmd* cmd)
+{
+    const Batch&      batch     = batches[*static_cast<const size_t*>(cmd->UserCallbackData)];
+    const MarkerMesh& mesh      = marker_meshes[batch.marker];
+    const GLsizei     instances = static_cast<GLsizei>(batch.vertices.size() / 2);
+
+    glUseProgram(marker_program);
+    setup_render_state(cmd, marker_loc_proj);
+
+    glUniform4fv(marker_loc_transform, 1, batch.transform);
+    glUniform1f(marker_loc_size, batch.size);
+
+    // the instanced attribute reads from `vbo`, bound to the vertex array in `init_markers`
+    glBindVertexArray(marker_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(batch.vertices.size() * sizeof(float)),
+                 batch.vertices.data(),
+                 GL_STREAM_DRAW);
+
+    if (batch.render_fill && mesh.fill_count > 0)
+    {
+        glUniform4fv(marker_loc_color, 1, batch.fill_color);
+        glDrawArraysInstanced(GL_TRIANGLE_FAN, mesh.fill_first, mesh.fill_count, instances);
+    }
+
+    if (batch.render_line)
+    {
+        glUniform4fv(marker_loc_color, 1, batch.color);
+        glDrawArraysInstanced(mesh.line_mode, mesh.line_first, mesh.line_count, instances);
+    }
+}
+
+void LP::GpuPlot::plot_line(const char*   label,
+                            const double* xs,
+                            const double* ys,
+                            const int     count,
+                            const int     flags,
+                            const int     offset,
+                            const int     stride)
+{
+    // rotated buffers can't be searched for the visible range
+    if (!available || offset != 0)
+    {
+        ImPlot::PlotLine(label, xs, ys, count, flags, offset, stride);
+        return;
+    }
+
+    auto x_at = [&](const int i) -> double { return index_data(xs, i, stride); };
+    auto y_at = [&](const int i) -> double { return index_data(ys, i, stride); };
+
+    if (!ImPlot::BeginItem(label, flags, ImPlotCol_Line))
+        return;
+
+    if (ImPlot::GetCurrentPlot()->FitThisFrame)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            ImPlot::FitPoint(ImPlotPoint(x_at(i), y_at(i)));
+        }
+    }
+
+    const ImPlotNextItemData& item = ImPlot::GetItemData();
+
+    if (item.RenderLine && count > 1)
+    {
+        const ImPlotRect limits = ImPlot::GetPlotLimits();
+
+        // visible points, plus the ones just outside the limits so the line reaches the plot edges
+        int first = partition_index(0, count, [&](const int i) { return x_at(i) < limits.X.Min; });
+        int last  = partition_index(first, count, [&](const int i) { return x_at(i) <= limits.X.Max; });
+
+        first = ImMax(first - 1, 0);
+        last  = ImMin(last + 1, count);
+
+        Batch& batch = next_batch();
+
+        batch.vertices.reserve(static_cast<size_t>(last - first) * 2);
+
+        for (int i = first; i < last; i++)
+        {
+            const double x = x_at(i);
+            const double y = y_at(i);
+
+            if (std::isnan(x) || std::isnan(y))
+                continue;
+
+            const GLint vertex = static_cast<GLint>(batch.vertices.size() / 2);
+
+            // start a new strip after a gap
+            if (i == first || std::isnan(x_at(i - 1)) || std::isnan(y_at(i - 1)))
+            {
+                batch.strip_first.push_back(vertex);
+                batch.strip_count.push_back(0);
+            }
+
+            batch.vertices.push_back(static_cast<float>(x - limits.X.Min));
+            batch.vertices.push_back(static_cast<float>(y - limits.Y.Min));
+            batch.strip_count.back()++;
+        }
+
+        const ImVec2 origin = ImPlot::PlotToPixels(limits.X.Min, limits.Y.Min);
+        const ImVec2 corner = ImPlot::PlotToPixels(limits.X.Max, limits.Y.Max);
+
+        batch.transform[0] = static_cast<float>((corner.x - origin.x) / limits.X.Size());
+        batch.transform[1] = static_cast<float>((corner.y - origin.y) / limits.Y.Size());
+        batch.transform[2] = origin.x;
+        batch.transform[3] = origin.y;
+
+        const ImVec4 color = item.Colors[ImPlotCol_Line];
+
+        batch.color[0] = color.x;
+        batch.color[1] = color.y;
+        batch.color[2] = color.z;
+        batch.color[3] = color.w;
+
+        size_t      index     = batch_count - 1;
+        ImDrawList* draw_list = ImPlot::GetPlotDrawList();
+
+        // the index is copied in the draw list, the batches are still alive when the draw data is rendered
+        draw_list->AddCallback(render_line, &index, sizeof(index));
+        draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+    }
+
+    ImPlot::EndItem();
+}
+
+void LP::GpuPlot::plot_scatter(const char*   label,
+                               const double* xs,
+                               const double* ys,
+                               const int     count,
+                               const int     flags,
+                               const int     offset,
+                               const int     stride)
+{
+    // rotated buffers can't be searched for the visible range
+    if (!instancing || offset != 0)
+    {
+        ImPlot::PlotScatter(label, xs, ys, count, flags, offset, stride);
+        return;
+    }
+
+    auto x_at = [&](const int i) -> double { return index_data(xs, i, stride); };
+    auto y_at = [&](const int i) -> double { return index_data(ys, i, stride); };
+
+    if (!ImPlot::BeginItem(label, flags, ImPlotCol_MarkerOutline))
+        return;
+
+    if (ImPlot::GetCurrentPlot()->FitThisFrame)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            ImPlot::FitPoint(ImPlotPoint(x_at(i), y_at(i)));
+        }
+    }
+
+    const ImPlotNextItemData& item = ImPlot::GetItemData();
+
+    if (count > 0 && (item.RenderMarkerFill || item.RenderMarkerLine))
+    {
+        const ImPlotRect limits = ImPlot::GetPlotLimits();
+
+        // visible points, plus the ones just outside the limits whose marker may still be partially visible
+        int first = partition_index(0, count, [&](const int i) { return x_at(i) < limits.X.Min; });
+        int last  = partition_index(first, count, [&](const int i) { return x_at(i) <= limits.X.Max; });
+
+        first = ImMax(first - 1, 0);
+        last  = ImMin(last + 1, count);
+
+        Batch& batch = next_batch();
+
+        batch.vertices.reserve(static_cast<size_t>(last - first) * 2);
+
+        for (int i = first; i < last; i++)
+        {
+            const double x = x_at(i);
+            const double y = y_at(i);
+
+            if (std::isnan(x) || std::isnan(y))
+                continue;
+
+            batch.vertices.push_back(static_cast<float>(x - limits.X.Min));
+            batch.vertices.push_back(static_cast<float>(y - limits.Y.Min));
+        }
+
+        const ImVec2 origin = ImPlot::PlotToPixels(limits.X.Min, limits.Y.Min);
+        const ImVec2 corner = ImPlot::PlotToPixels(limits.X.Max, limits.Y.Max);
+
+        batch.transform[0] = static_cast<float>((corner.x - origin.x) / limits.X.Size());
+        batch.transform[1] = static_cast<float>((corner.y - origin.y) / limits.Y.Size());
+        batch.transform[2] = origin.x;
+        batch.transform[3] = origin.y;
+
+        const ImVec4 line_color = item.Colors[ImPlotCol_MarkerOutline];
+        const ImVec4 fill_color = item.Colors[ImPlotCol_MarkerFill];
+
+        batch.color[0]      = line_color.x;
+        batch.color[1]      = line_color.y;
+        batch.color[2]      = line_color.z;
+        batch.color[3]      = line_color.w;
+        batch.fill_color[0] = fill_color.x;
+        batch.fill_color[1] = fill_color.y;
+        batch.fill_color[2] = fill_color.z;
+        batch.fill_color[3] = fill_color.w;
+
+        // outlines are always drawn as hairlines, regardless of the marker weight
+        batch.marker      = (item.Marker == ImPlotMarker_None) ? ImPlotMarker_Circle : item.Marker;
+        batch.size        = item.MarkerSize;
+        batch.render_fill = item.RenderMarkerFill;
+        batch.render_line = item.RenderMarkerLine;
+
+        size_t      index     = batch_count - 1;
+        ImDrawList* draw_list = ImPlot::GetPlotDrawList();
+
+        draw_list->AddCallback(render_markers, &index, sizeof(index));
+        draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+    }
+
+    ImPlot::EndItem();
+}
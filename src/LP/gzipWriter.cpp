@@ -0,0 +1,190 @@
+#include <LP/gzipWriter.h>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+LP::GzipWriter::~GzipWriter()
+{
+    close();
+}
+
+bool LP::GzipWriter::open(const std::string& path, const int level)
+{
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    failed  = false;
+    closing = false;
+    worker  = std::thread(&GzipWriter::run, this, level);
+
+    return true;
+}
+
+bool LP::GzipWriter::write(std::string& block, const bool flush, const bool sync)
+{
+    std::string empty;
+
+    {
+        std::unique_lock lock(mtx);
+        cv.wait(lock, [this]() { return queue.size() < GZIP_QUEUE_BLOCKS || failed; });
+
+        if (failed)
+        {
+            block.clear();
+            return false;
+        }
+
+        if (!spares.empty())
+        {
+            empty = std::move(spares.back());
+            spares.pop_back();
+        }
+
+        queue.push_back({std::move(block), flush, sync});
+    }
+
+    cv.notify_all();
+
+    block = std::move(empty);
+
+    return true;
+}
+
+bool LP::GzipWriter::close()
+{
+    if (file == nullptr)
+    {
+        return !failed;
+    }
+
+    {
+        std::lock_guard lock(mtx);
+        closing = true;
+    }
+
+    cv.notify_all();
+
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+
+    if (std::fclose(file) != 0)
+    {
+        failed = true;
+    }
+
+    file = nullptr;
+    spares.clear();
+
+    return !failed;
+}
+
+void LP::GzipWriter::run(const int level)
+{
+    z_stream stream = {};
+
+    // 16 more window bits select the gzip wrapper
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        failed = true;
+        cv.notify_all();
+        return;
+    }
+
+    std::vector<unsigned char> out(GZIP_OUT_CHUNK);
+
+    while (true)
+    {
+        Block block;
+        bool  finish;
+
+        {
+            std::unique_lock lock(mtx);
+            cv.wait(lock, [this]() { return !queue.empty() || closing; });
+
+            finish = queue.empty();
+
+            if (!finish)
+            {
+                block = std::move(queue.front());
+                queue.pop_front();
+            }
+        }
+
+        cv.notify_all();
+
+        const int mode = finish ? Z_FINISH : (block.flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+
+        stream.next_in  = reinterpret_cast<Bytef*>(block.data.data());
+        stream.avail_in = static_cast<uInt>(block.data.size());
+
+        // deflate until the output buffer isn't filled anymore: the input is consumed and flushed as asked
+        do
+        {
+            stream.next_out  = out.data();
+            stream.avail_out = static_cast<uInt>(out.size());
+
+            deflate(&stream, mode);
+
+            const size_t have = out.size() - stream.avail_out;
+
+            if (!failed && std::fwrite(out.data(), 1, have, file) != have)
+            {
+                std::cerr << "Error while writing compressed file." << std::endl;
+                failed = true;
+                cv.notify_all();
+            }
+        } while (stream.avail_out == 0);
+
+        if (finish)
+        {
+            break;
+        }
+
+        if (block.flush && !failed && std::fflush(file) != 0)
+        {
+            failed = true;
+            cv.notify_all();
+        }
+
+        if (block.sync && !failed)
+        {
+#ifndef _WIN32
+            fsync(fileno(file));
+#else
+            _commit(_fileno(file));
+#endif
+        }
+
+        block.data.clear();
+
+        std::lock_guard lock(mtx);
+        spares.push_back(std::move(block.data));
+    }
+
+    deflateEnd(&stream);
+}
+
+bool LP::GzipWriter::is_gzip_path(const std::string& path)
+{
+    return std::filesystem::path(path).extension() == ".gz";
+}
@@ -0,0 +1,198 @@
+#include <LP/csvImport.h>
+#include <LP/importJob.h>
+#include <LP/lpcap.h>
+#include <LP/recordIndex.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <ranges>
+#include <mutex>
+#include <string>
+#include <thread>
+
+LP::ImportJob::~ImportJob()
+{
+    stop();
+}
+
+bool LP::ImportJob::start(Telemetry& tel, const std::string& path, const double from, const double to)
+{
+    poll();
+
+    if (running)
+    {
+        return false;
+    }
+
+    cancelled = false;
+    completed = false;
+    work_done = 0;
+
+    const std::filesystem::path extension = std::filesystem::path(path).extension();
+
+    if (extension == ".csv" || extension == ".lpidx")
+    {
+        csv_paths.clear();
+
+        if (extension == ".lpidx")
+        {
+            RecordIndex index;
+
+            if (!index.load(path))
+            {
+                std::cerr << "Error while opening " << path << ": not a valid index file." << std::endl;
+                return false;
+            }
+
+            // the files are picked from the index alone
+            const auto [first, last] = index.find_range(from, to);
+
+            // a file without rows yet, just rotated, holds nothing to parse
+            for (size_t segment = first; segment < last; segment++)
+            {
+                if (index.get_segments()[segment].rows > 0)
+                    csv_paths.push_back(index.get_path(segment));
+            }
+
+            if (csv_paths.empty())
+            {
+                std::cerr << "Error while opening " << path << ": no recorded rows in the time range." << std::endl;
+                return false;
+            }
+        }
+        else
+        {
+            csv_paths.push_back(path);
+        }
+
+        work_total = 0;
+
+        for (const std::string& csv_path : csv_paths)
+        {
+            std::error_code ec;
+            work_total += std::filesystem::file_size(csv_path, ec);
+
+            if (ec)
+            {
+                std::cerr << "Error while opening " << csv_path << ": " << ec.message() << std::endl;
+                return false;
+            }
+        }
+
+        running = true;
+        worker  = std::thread(&ImportJob::run_csv, this, std::ref(tel));
+
+        return true;
+    }
+
+    if (!capture.open(path))
+    {
+        std::cerr << "Error while opening " << path << ": not a valid capture file." << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        tel.clear(true);
+        tel.frame_format = capture.get_frame_format();
+    }
+
+    work_total       = capture.get_rows();
+    overview_unix    = capture.get_overview(DATETIME);
+    overview_elapsed = capture.get_overview(ELAPSED);
+    running          = true;
+
+    worker = std::thread(&ImportJob::run, this, std::ref(tel));
+
+    return true;
+}
+
+void LP::ImportJob::run(Telemetry& tel)
+{
+    for (size_t chunk = 0; chunk < capture.get_chunks().size() && !cancelled; chunk++)
+    {
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+            capture.load_chunk(chunk, tel);
+        }
+
+        work_done += capture.get_chunks()[chunk].rows;
+    }
+
+    capture.close();
+
+    running = false;
+}
+
+void LP::ImportJob::run_csv(Telemetry& tel)
+{
+    if (!CsvImport::load(csv_paths, tel, &work_done, &cancelled))
+    {
+        if (!cancelled)
+        {
+            std::cerr << "Error while opening " << csv_paths.front() << ": not a valid CSV file." << std::endl;
+        }
+
+        running = false;
+        return;
+    }
+
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        Extents y;
+
+        for (const Channel& channel : *tel.get_data() | std::views::values)
+        {
+            const Extents total = channel.extents.total();
+
+            if (total.valid())
+            {
+                y.extend(total.min * channel.scale + channel.offset);
+                y.extend(total.max * channel.scale + channel.offset);
+            }
+        }
+
+        if (!y.valid())
+        {
+            y = {0, 1};
+        }
+
+        const std::vector<double>& times_unix    = *tel.get_unix_timestamps();
+        const std::vector<double>& times_elapsed = *tel.get_elapsed_timestamps();
+
+        if (!times_unix.empty())
+        {
+            overview_unix    = {times_unix.front(), times_unix.back(), y.min, y.max};
+            overview_elapsed = {times_elapsed.front(), times_elapsed.back(), y.min, y.max};
+        }
+    }
+
+    completed = true;
+    running   = false;
+}
+
+void LP::ImportJob::poll()
+{
+    if (!running && worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void LP::ImportJob::stop()
+{
+    cancelled = true;
+
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+float LP::ImportJob::get_progress() const
+{
+    return (work_total == 0) ? 0.0f : std::min(1.0f, static_cast<float>(work_done) / static_cast<float>(work_total));
+}
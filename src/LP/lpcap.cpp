@@ -0,0 +1,414 @@
+#include <LP/lpcap.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    constexpr char HEADER_MAGIC[8]  = {'L', 'P', 'C', 'A', 'P', '\r', '\n', '\x1A'};
+    constexpr char TRAILER_MAGIC[8] = {'L', 'P', 'C', 'A', 'P', 'E', 'N', 'D'};
+
+    template <typename T> void put(std::string& out, const T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void put_string(std::string& out, const std::string& value)
+    {
+        put<uint32_t>(out, static_cast<uint32_t>(value.size()));
+        out += value;
+    }
+
+    // bounds checked cursor over the mapped file; once a read fails every following read fails too
+    struct Reader {
+        const char* data;
+        size_t      size;
+        size_t      pos = 0;
+        bool        ok  = true;
+
+        template <typename T> T get()
+        {
+            T value{};
+
+            if (ok && pos + sizeof(T) <= size)
+            {
+                std::memcpy(&value, data + pos, sizeof(T));
+                pos += sizeof(T);
+            }
+            else
+            {
+                ok = false;
+            }
+
+            return value;
+        }
+
+        std::string get_string()
+        {
+            const auto length = get<uint32_t>();
+
+            if (!ok || pos + length > size)
+            {
+                ok = false;
+                return "";
+            }
+
+            std::string value(data + pos, length);
+            pos += length;
+
+            return value;
+        }
+    };
+
+    // copy a string in one of the fixed size frame format fields
+    bool set_format_field(char (&field)[255], const std::string& value)
+    {
+        if (value.size() >= sizeof(field))
+        {
+            return false;
+        }
+
+        std::memcpy(field, value.c_str(), value.size() + 1);
+        return true;
+    }
+}
+
+bool LP::LpCapFile::save(const std::string&       path,
+                         const Telemetry&         tel,
+                         std::atomic<size_t>*     progress,
+                         const std::atomic<bool>* cancel)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+    if (!out.is_open())
+    {
+        std::cerr << "Error while opening capture file." << std::endl;
+        return false;
+    }
+
+    FrameFormat               format;
+    std::vector<LpCapChannel> channels;
+    size_t                    rows;
+
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        format = tel.frame_format;
+        rows   = tel.get_unix_timestamps()->size();
+
+        for (const auto& [id, channel] : *tel.get_data())
+        {
+            channels.push_back({id, channel.name, channel.scale, channel.offset});
+        }
+    }
+
+    std::ranges::sort(channels, {}, &LpCapChannel::id);
+
+    // === header ===
+    std::string buffer(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+
+    put<uint32_t>(buffer, LPCAP_VERSION);
+    put<uint8_t>(buffer, format.named ? 1 : 0);
+    put_string(buffer, format.channel_sep);
+    put_string(buffer, format.frame_end);
+    put_string(buffer, format.name_sep);
+    put<uint32_t>(buffer, static_cast<uint32_t>(channels.size()));
+
+    for (const LpCapChannel& channel : channels)
+    {
+        put<int32_t>(buffer, channel.id);
+        put_string(buffer, channel.name);
+        put<double>(buffer, channel.scale);
+        put<double>(buffer, channel.offset);
+    }
+
+    // chunks are aligned, so that the mapped columns can be read in place
+    buffer.resize((buffer.size() + 7) / 8 * 8, '\0');
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    // === chunks ===
+    uint64_t                position = buffer.size();
+    std::vector<LpCapChunk> index;
+    std::vector<double>     block;
+
+    for (size_t first = 0; first < rows; first += LPCAP_CHUNK_ROWS)
+    {
+        const size_t count = std::min<size_t>(LPCAP_CHUNK_ROWS, rows - first);
+
+        LpCapChunk chunk = {position, count, 0, 0, 0, 0, {}};
+        block.assign(count * (2 + channels.size()), std::nan(""));
+
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+
+            const std::vector<double>& times_unix    = *tel.get_unix_timestamps();
+            const std::vector<double>& times_elapsed = *tel.get_elapsed_timestamps();
+
+            if (times_unix.size() < first + count)
+            {
+                std::cerr << "The data was cleared while saving the capture." << std::endl;
+                return false;
+            }
+
+            std::copy_n(times_unix.begin() + first, count, block.begin());
+            std::copy_n(times_elapsed.begin() + first, count, block.begin() + count);
+
+            for (size_t c = 0; c < channels.size(); c++)
+            {
+                const auto channel = tel.get_data()->find(channels[c].id);
+
+                if (channel == tel.get_data()->end() || channel->second.values.size() <= first)
+                {
+                    chunk.extents.emplace_back();
+                    continue;
+                }
+
+                const std::vector<double>& values = channel->second.values;
+                const size_t               n      = std::min(count, values.size() - first);
+
+                std::copy_n(values.begin() + first, n, block.begin() + (2 + c) * count);
+                chunk.extents.push_back(channel->second.extents.query(values, first, first + n));
+            }
+        }
+
+        chunk.unix_first    = block[0];
+        chunk.unix_last     = block[count - 1];
+        chunk.elapsed_first = block[count];
+        chunk.elapsed_last  = block[2 * count - 1];
+
+        out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size() * 8));
+
+        position += block.size() * 8;
+        index.push_back(std::move(chunk));
+
+        if (progress != nullptr)
+            progress->store(first + count, std::memory_order_relaxed);
+
+        if (cancel != nullptr && cancel->load(std::memory_order_relaxed))
+            return false;
+    }
+
+    // === index and trailer ===
+    buffer.clear();
+    put<uint64_t>(buffer, index.size());
+
+    for (const LpCapChunk& chunk : index)
+    {
+        put<uint64_t>(buffer, chunk.offset);
+        put<uint64_t>(buffer, chunk.rows);
+        put<double>(buffer, chunk.unix_first);
+        put<double>(buffer, chunk.unix_last);
+        put<double>(buffer, chunk.elapsed_first);
+        put<double>(buffer, chunk.elapsed_last);
+
+        for (const Extents& extents : chunk.extents)
+        {
+            put<double>(buffer, extents.min);
+            put<double>(buffer, extents.max);
+        }
+    }
+
+    put<uint64_t>(buffer, position);
+    buffer.append(TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.close();
+
+    if (out.fail())
+    {
+        std::cerr << "Error while writing capture file." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool LP::LpCapFile::open(const std::string& path)
+{
+    channels.clear();
+    chunks.clear();
+    frame_format = FrameFormat();
+
+    if (!file.open(path))
+    {
+        return false;
+    }
+
+    const char*  data = file.get_data();
+    const size_t size = file.get_size();
+
+    const auto invalid = [this]()
+    {
+        file.close();
+        channels.clear();
+        chunks.clear();
+        return false;
+    };
+
+    if (size < sizeof(HEADER_MAGIC) + 16 || std::memcmp(data, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0 ||
+        std::memcmp(data + size - sizeof(TRAILER_MAGIC), TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0)
+    {
+        return invalid();
+    }
+
+    uint64_t index_offset;
+    std::memcpy(&index_offset, data + size - 16, sizeof(index_offset));
+
+    // === header ===
+    Reader header = {data, std::min<size_t>(index_offset, size), sizeof(HEADER_MAGIC)};
+
+    if (header.get<uint32_t>() != LPCAP_VERSION)
+    {
+        return invalid();
+    }
+
+    frame_format.named = header.get<uint8_t>() != 0;
+
+    if (!set_format_field(frame_format.channel_sep, header.get_string()) ||
+        !set_format_field(frame_format.frame_end, header.get_string()) ||
+        !set_format_field(frame_format.name_sep, header.get_string()))
+    {
+        return invalid();
+    }
+
+    const auto channel_count = header.get<uint32_t>();
+
+    for (uint32_t c = 0; c < channel_count && header.ok; c++)
+    {
+        LpCapChannel channel;
+        channel.id     = header.get<int32_t>();
+        channel.name   = header.get_string();
+        channel.scale  = header.get<double>();
+        channel.offset = header.get<double>();
+
+        channels.push_back(std::move(channel));
+    }
+
+    if (!header.ok)
+    {
+        return invalid();
+    }
+
+    // === index ===
+    Reader index = {data, size - 16, static_cast<size_t>(index_offset)};
+
+    const auto chunk_count = index.get<uint64_t>();
+
+    for (uint64_t i = 0; i < chunk_count && index.ok; i++)
+    {
+        LpCapChunk chunk;
+        chunk.offset        = index.get<uint64_t>();
+        chunk.rows          = index.get<uint64_t>();
+        chunk.unix_first    = index.get<double>();
+        chunk.unix_last     = index.get<double>();
+        chunk.elapsed_first = index.get<double>();
+        chunk.elapsed_last  = index.get<double>();
+
+        for (size_t c = 0; c < channels.size(); c++)
+        {
+            Extents extents;
+            extents.min = index.get<double>();
+            extents.max = index.get<double>();
+
+            chunk.extents.push_back(extents);
+        }
+
+        // the chunk must lie between the header and the index
+        if (chunk.offset % 8 != 0 || chunk.rows > LPCAP_CHUNK_ROWS || chunk.offset > index_offset ||
+            chunk.rows * (2 + channels.size()) * 8 > index_offset - chunk.offset)
+        {
+            return invalid();
+        }
+
+        chunks.push_back(std::move(chunk));
+    }
+
+    if (!index.ok)
+    {
+        return invalid();
+    }
+
+    return true;
+}
+
+void LP::LpCapFile::load_chunk(const size_t chunk, Telemetry& tel) const
+{
+    const LpCapChunk& entry = chunks.at(chunk);
+
+    // aligned, since the mapping starts on a page boundary and chunks on 8 bytes
+    const auto*  columns = reinterpret_cast<const double*>(file.get_data() + entry.offset);
+    const size_t rows    = entry.rows;
+
+    std::vector<std::pair<int, const double*>> values;
+
+    for (size_t c = 0; c < channels.size(); c++)
+    {
+        values.emplace_back(channels[c].id, columns + (2 + c) * rows);
+    }
+
+    tel.push_columns(columns, columns + rows, rows, values);
+
+    if (chunk == 0)
+    {
+        for (const LpCapChannel& channel : channels)
+        {
+            Channel& loaded = (*tel.get_data())[channel.id];
+
+            loaded.name   = channel.name;
+            loaded.scale  = channel.scale;
+            loaded.offset = channel.offset;
+        }
+    }
+}
+
+LP::Limits LP::LpCapFile::get_overview(const PlotTimeStyle ts) const
+{
+    if (chunks.empty())
+    {
+        return {0, 1, 0, 1};
+    }
+
+    Extents y;
+
+    for (const LpCapChunk& chunk : chunks)
+    {
+        for (size_t c = 0; c < channels.size(); c++)
+        {
+            if (!chunk.extents[c].valid())
+                continue;
+
+            y.extend(chunk.extents[c].min * channels[c].scale + channels[c].offset);
+            y.extend(chunk.extents[c].max * channels[c].scale + channels[c].offset);
+        }
+    }
+
+    if (!y.valid())
+    {
+        y = {0, 1};
+    }
+
+    return (ts == DATETIME) ? Limits{chunks.front().unix_first, chunks.back().unix_last, y.min, y.max}
+                            : Limits{chunks.front().elapsed_first, chunks.back().elapsed_last, y.min, y.max};
+}
+
+size_t LP::LpCapFile::get_rows() const
+{
+    size_t rows = 0;
+
+    for (const LpCapChunk& chunk : chunks)
+    {
+        rows += chunk.rows;
+    }
+
+    return rows;
+}
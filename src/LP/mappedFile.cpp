@@ -0,0 +1,111 @@
+#include <LP/mappedFile.h>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+bool LP::MappedFile::open(const std::string& path)
+{
+    close();
+
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st{};
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+
+    if (mapped == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // read front to back
+    madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    data = static_cast<const char*>(mapped);
+    size = static_cast<size_t>(st.st_size);
+#else
+    HANDLE file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    file_handle    = file;
+    mapping_handle = mapping;
+    data           = static_cast<const char*>(view);
+    size           = static_cast<size_t>(file_size.QuadPart);
+#endif
+
+    return true;
+}
+
+void LP::MappedFile::close()
+{
+    if (data == nullptr)
+    {
+        return;
+    }
+
+#ifndef _WIN32
+    munmap(const_cast<char*>(data), size);
+#else
+    UnmapViewOfFile(data);
+    CloseHandle(mapping_handle);
+    CloseHandle(file_handle);
+
+    file_handle    = nullptr;
+    mapping_handle = nullptr;
+#endif
+
+    data = nullptr;
+    size = 0;
+}
@@ -0,0 +1,271 @@
+#include <LP/persistence.h>
+#include <algorithm>
+#include <cmath>
+#include <glad/glad.h>
+#include <imgui.h>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../implot/implot.h"
+
+void LP::Persistence::update(const std::unordered_map<int, Channel>&    data,
+                             const std::vector<double>&                 times,
+                             const std::vector<std::pair<int, ImVec4>>& channels,
+                             const double                               length,
+                             const PlotTimeStyle                        ts)
+{
+    bool restart_needed = layers.empty() || layers.size() != channels.size() || times.size() < splatted ||
+                          ts != time_style || length != sweep_length;
+
+    for (const auto& [ch_id, color] : channels)
+    {
+        const auto layer   = layers.find(ch_id);
+        const auto channel = data.find(ch_id);
+
+        if (layer == layers.end() || channel == data.end() || layer->second.scale != channel->second.scale ||
+            layer->second.offset != channel->second.offset)
+        {
+            restart_needed = true;
+            break;
+        }
+
+        if (layer->second.color.x != color.x || layer->second.color.y != color.y ||
+            layer->second.color.z != color.z || layer->second.color.w != color.w)
+        {
+            layer->second.color = color;
+            dirty               = true;
+        }
+    }
+
+    time_style   = ts;
+    sweep_length = length;
+
+    if (restart_needed)
+    {
+        restart(data, times, channels);
+    }
+
+    if (times.empty() || sweep_length <= 0)
+    {
+        return;
+    }
+
+    const auto sweep_of = [this](const double t)
+    { return static_cast<long long>(std::floor((t - origin) / sweep_length)); };
+
+    const auto to_pixel_x = [this](const double t, const long long s)
+    {
+        const double x = (t - origin - s * sweep_length) / sweep_length * PERSISTENCE_WIDTH;
+        return static_cast<float>(std::clamp(x, 0.0, PERSISTENCE_WIDTH - 1.0));
+    };
+
+    // rows go from top to bottom
+    const auto to_pixel_y = [this](const double y)
+    {
+        const double py = (y_max - y) / (y_max - y_min) * PERSISTENCE_HEIGHT;
+        return static_cast<float>(std::clamp(py, 0.0, PERSISTENCE_HEIGHT - 1.0));
+    };
+
+    for (size_t i = splatted; i < times.size(); i++)
+    {
+        const long long s = sweep_of(times[i]);
+
+        // a new sweep begins: fade everything drawn so far, once for every sweep passed
+        if (s > sweep)
+        {
+            const float fade = std::pow(decay, static_cast<float>(s - sweep));
+
+            for (auto& layer : layers | std::views::values)
+            {
+                if (fade < 1e-4f)
+                {
+                    std::ranges::fill(layer.density, 0.0f);
+                }
+                else
+                {
+                    for (float& d : layer.density)
+                        d *= fade;
+                }
+            }
+
+            sweep = s;
+        }
+
+        const float x = to_pixel_x(times[i], s);
+
+        for (auto& [ch_id, layer] : layers)
+        {
+            const std::vector<double>& values = data.at(ch_id).values;
+
+            if (i >= values.size() || std::isnan(values[i]))
+                continue;
+
+            const float y = to_pixel_y(values[i] * layer.scale + layer.offset);
+
+            // connect to the previous sample, if it belongs to the same sweep
+            if (i > 0 && !std::isnan(values[i - 1]) && sweep_of(times[i - 1]) == s)
+            {
+                const float prev_y = to_pixel_y(values[i - 1] * layer.scale + layer.offset);
+
+                splat(layer, to_pixel_x(times[i - 1], s), prev_y, x, y);
+            }
+            else
+            {
+                splat(layer, x, y, x, y);
+            }
+        }
+
+        dirty = true;
+    }
+
+    splatted = times.size();
+}
+
+void LP::Persistence::restart(const std::unordered_map<int, Channel>&    data,
+                              const std::vector<double>&                 times,
+                              const std::vector<std::pair<int, ImVec4>>& channels)
+{
+    layers.clear();
+
+    Extents range;
+
+    for (const auto& [ch_id, color] : channels)
+    {
+        const auto channel = data.find(ch_id);
+
+        if (channel == data.end())
+            continue;
+
+        layers[ch_id] = {std::vector<float>(PERSISTENCE_WIDTH * PERSISTENCE_HEIGHT, 0.0f),
+                         color,
+                         channel->second.scale,
+                         channel->second.offset};
+
+        const Extents total = channel->second.extents.total();
+
+        if (total.valid())
+        {
+            range.extend(total.min * channel->second.scale + channel->second.offset);
+            range.extend(total.max * channel->second.scale + channel->second.offset);
+        }
+    }
+
+    // values outside of the range are drawn on the image borders, until the next restart
+    y_min = range.valid() ? range.min : 0.0;
+    y_max = range.valid() ? range.max : 1.0;
+
+    if (y_min == y_max)
+    {
+        y_min -= 0.5;
+        y_max += 0.5;
+    }
+
+    origin   = times.empty() ? 0.0 : times.front();
+    sweep    = 0;
+    splatted = 0;
+    dirty    = true;
+}
+
+void LP::Persistence::splat(Layer& layer, const float x0, const float y0, const float x1, const float y1)
+{
+    const float dx    = x1 - x0;
+    const float dy    = y1 - y0;
+    const int   steps = std::max(1, static_cast<int>(std::ceil(std::max(std::abs(dx), std::abs(dy)))));
+
+    // the last point is left to the next segment, so that joints aren't hit twice
+    for (int k = 0; k < steps; k++)
+    {
+        const int x = static_cast<int>(x0 + dx * k / steps);
+        const int y = static_cast<int>(y0 + dy * k / steps);
+
+        layer.density[y * PERSISTENCE_WIDTH + x] += 1.0f;
+    }
+}
+
+void LP::Persistence::upload()
+{
+    pixels.resize(PERSISTENCE_WIDTH * PERSISTENCE_HEIGHT);
+
+    for (size_t p = 0; p < pixels.size(); p++)
+    {
+        float r = 0, g = 0, b = 0, a = 0;
+
+        for (const Layer& layer : layers | std::views::values)
+        {
+            if (layer.density[p] <= 0.0f)
+                continue;
+
+            const float intensity = 1.0f - std::exp(-layer.density[p] / PERSISTENCE_GAIN);
+
+            r += layer.color.x * intensity;
+            g += layer.color.y * intensity;
+            b += layer.color.z * intensity;
+            a  = std::max(a, intensity);
+        }
+
+        // the image is alpha blended over the plot, so the color is stored at full intensity
+        if (a > 0.0f)
+        {
+            r = std::min(r / a, 1.0f);
+            g = std::min(g / a, 1.0f);
+            b = std::min(b / a, 1.0f);
+        }
+
+        pixels[p] = IM_COL32(static_cast<int>(r * 255), static_cast<int>(g * 255), static_cast<int>(b * 255),
+                             static_cast<int>(a * 255));
+    }
+
+    GLint last_texture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+
+    if (texture == 0)
+    {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PERSISTENCE_WIDTH, PERSISTENCE_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     pixels.data());
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PERSISTENCE_WIDTH, PERSISTENCE_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE,
+                        pixels.data());
+    }
+
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+
+    dirty = false;
+}
+
+void LP::Persistence::plot()
+{
+    if (dirty)
+    {
+        upload();
+    }
+
+    if (texture != 0 && sweep_length > 0)
+    {
+        ImPlot::PlotImage("##persistence",
+                          ImTextureRef(static_cast<ImTextureID>(texture)),
+                          ImPlotPoint(0, y_min),
+                          ImPlotPoint(sweep_length, y_max));
+    }
+}
+
+void LP::Persistence::destroy()
+{
+    if (texture != 0)
+    {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
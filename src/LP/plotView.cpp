@@ -1,20 +1,32 @@
+#include <LP/geometryPrep.h>
+#include <LP/gpuPlot.h>
 #include <LP/plotView.h>
 #include <LP/telemetry.h>
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <format>
 #include <imgui.h>
+#include <iterator>
+#include <limits>
 #include <mutex>
+#include <ranges>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../fonts/lucide.h"
 #include "../implot/implot.h"
 #include "LP/shared.h"
 
-#define TEXT_BUFFER_SIZE 256
-
-void LP::PlotView::render_plot(
-    Telemetry& tel, app_state_t app_state, const float pos_x, const float pos_y, const float width, const float height)
+void LP::PlotView::render_plot(Telemetry&        tel,
+                               GeometryPrep&     prep,
+                               const app_state_t app_state,
+                               const float       pos_x,
+                               const float       pos_y,
+                               const float       width,
+                               const float       height)
 {
     std::lock_guard<std::mutex> lock(tel.get_data_mtx());
 
@@ -29,14 +41,83 @@ void LP::PlotView::render_plot(
     {
         if (!data->empty() && !times->empty())
         {
-            if (ImPlot::BeginPlot("##plot_win",
-                                  ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y)))
+            for (const auto& ch_id : *data | std::views::keys)
+            {
+                if (!plot_attributes.contains(ch_id))
+                {
+                    channel_style_init(ch_id);
+                }
+            }
+
+            const double first_time = times->front();
+            const double last_time  = times->back();
+
+            int time_window = LP::time_windows[combobox_time_index].value;
+
+            if (plot_style.time_style == ELAPSED)
+            {
+                time_window *= 1000;
+            }
+
+            // Set time window, if there is.
+            double window_start = (time_window != 0) ? std::max(first_time, last_time - time_window) : first_time;
+
+            // index of the first sample in the time window
+            const size_t first = std::lower_bound(times->begin(), times->end(), window_start) - times->begin();
+
+            if (plot_style.persistence)
+            {
+                // sweeps last one time window, or a second when there is none
+                const double sweep_length =
+                    (time_window != 0) ? time_window : (plot_style.time_style == ELAPSED) ? 1000 : 1;
+
+                render_persistence(*data, *times, app_state, sweep_length, ImGui::GetContentRegionAvail());
+
+                ImGui::End();
+                return;
+            }
+
+            const auto spectrogram_channel = data->find(plot_style.spectrogram_channel);
+            const bool show_spectrogram    = spectrogram_channel != data->end();
+
+            // leave room for the overview and the spectrogram under the plot
+            const float  spacing = ImGui::GetStyle().ItemSpacing.y;
+            const ImVec2 plot_size(ImGui::GetContentRegionAvail().x,
+                                   ImGui::GetContentRegionAvail().y - OVERVIEW_HEIGHT - spacing -
+                                       (show_spectrogram ? SPECTROGRAM_HEIGHT + spacing : 0.0f));
+
+            // ask for the points of the next frame, and draw the ones prepared for the previous frames if they still
+            // cover the view
+            const Limits view = current_view(app_state, window_start, last_time);
+
+            post_prep_request(prep, *data, view, plot_size.x, times->size());
+
+            std::lock_guard<std::mutex> prep_lock(prep.get_front_mtx());
+
+            const PreparedFrame* prepared =
+                prep.get_front().covers(view.x_min, view.x_max, plot_style.time_style) ? &prep.get_front() : nullptr;
+
+            // bitfields are drawn from their value runs, in the single plot as in the lanes
+            Telemetry::update_runs(*data, plot_attributes);
+
+            if (plot_style.strip_chart)
+            {
+                // the lanes' X axes are linked, the view set from the overview is applied to all of them at once
+                if (view_request && app_state != READING)
+                {
+                    lanes_x_min = view_x_min;
+                    lanes_x_max = view_x_max;
+                }
+
+                render_lanes(*data, *times, prepared, app_state, window_start, first, plot_size);
+                view_request   = false;
+                view_y_request = false;
+            }
+            else if (ImPlot::BeginPlot("##plot_win", plot_size))
             {
                 ImPlot::SetupAxis(ImAxis_X1, "Time");
 
-                ImPlot::SetupAxis(ImAxis_Y1,
-                                  "##Data",
-                                  (app_state == READING) ? ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_RangeFit : 0);
+                ImPlot::SetupAxis(ImAxis_Y1, "##Data");
 
                 if (plot_style.time_style == DATETIME)
                 {
@@ -45,72 +126,492 @@ void LP::PlotView::render_plot(
 
                 ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_NoButtons);
 
-                const double first_time = times->front();
-                const double last_time  = times->back();
-
-                int time_window = LP::time_windows[combobox_time_index].value;
+                if (view_request && app_state != READING)
+                {
+                    ImPlot::SetupAxisLimits(ImAxis_X1, view_x_min, view_x_max, ImGuiCond_Always);
+                }
 
-                if (plot_style.time_style == ELAPSED)
+                if (view_y_request && app_state != READING)
                 {
-                    time_window *= 1000;
+                    ImPlot::SetupAxisLimits(ImAxis_Y1, view_y_min, view_y_max, ImGuiCond_Always);
                 }
 
-                // Set time window, if there is.
-                double window_start = (time_window != 0) ? std::max(first_time, last_time - time_window) : first_time;
+                view_request   = false;
+                view_y_request = false;
 
                 if (app_state == READING)
+                {
                     ImPlot::SetupAxisLimits(ImAxis_X1, window_start, last_time, ImGuiCond_Always);
 
+                    // fit the Y axis to the visible window using the channels range index, instead of letting
+                    // ImPlot scan every plotted point each frame
+                    Extents visible;
+
+                    for (auto& [ch_id, channel] : *data)
+                    {
+                        // digital lanes don't use the Y axis
+                        if (plot_attributes[ch_id].show && plot_attributes[ch_id].bits == 0)
+                        {
+                            visible.merge(channel_extents(channel, *times, first));
+                        }
+                    }
+
+                    fit_y_axis(visible);
+                }
+
                 // get plot window limits and set the time window (used when saving the plot)
                 const ImPlotRect limits = ImPlot::GetPlotLimits(ImAxis_X1, ImAxis_Y1);
                 plot_style.limits       = {limits.Min().x, limits.Max().x, limits.Min().y, limits.Max().y};
 
                 for (auto& [ch_id, channel] : *data)
                 {
-
-                    if (!plot_attributes.contains(ch_id))
+                    if (plot_attributes[ch_id].show)
                     {
-                        channel_style_init(ch_id);
+                        plot_channel(ch_id, channel, *times, prepared);
                     }
+                }
 
-                    if (plot_attributes[ch_id].show)
-                    {
-                        std::string label = std::format("{}##{}", channel.name, ch_id);
+                ImPlot::EndPlot();
+            }
 
-                        ImPlot::PushStyleColor(ImPlotCol_Line, plot_attributes[ch_id].color);
-                        ImPlot::PushStyleColor(ImPlotCol_MarkerOutline, plot_attributes[ch_id].color);
-                        ImPlot::PushStyleColor(ImPlotCol_MarkerFill, plot_attributes[ch_id].color);
-                        ImPlot::PushStyleColor(ImPlotCol_Fill, plot_attributes[ch_id].color);
+            if (show_spectrogram)
+            {
+                render_spectrogram(spectrogram_channel->first, spectrogram_channel->second, *times);
+            }
 
-                        std::vector<double> values_transformed;
+            render_overview(*data, *times, app_state);
+        }
+        else
+        {
+            ImPlot::BeginPlot("##plot_win", ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y));
+            ImPlot::EndPlot();
+        }
 
-                        values_transformed.reserve(channel.values.size());
-                        for (size_t i = 0; i < channel.values.size(); ++i)
-                        {
-                            values_transformed.push_back(channel.values[i] * channel.scale + channel.offset);
-                        }
+        ImGui::End();
+    }
+}
+
+void LP::PlotView::render_lanes(std::unordered_map<int, Channel>& data,
+                                const std::vector<double>&        times,
+                                const PreparedFrame*              prepared,
+                                const app_state_t                 app_state,
+                                const double                      window_start,
+                                const size_t                      first,
+                                const ImVec2                      size)
+{
+    // one lane per shown channel, ordered by id
+    std::vector<int> lanes;
+
+    for (const auto& ch_id : data | std::views::keys)
+    {
+        if (plot_attributes[ch_id].show)
+            lanes.push_back(ch_id);
+    }
+
+    std::ranges::sort(lanes);
+
+    if (app_state == READING)
+    {
+        lanes_x_min = window_start;
+        lanes_x_max = times.back();
+    }
+
+    if (ImGui::BeginChild("##lanes", size) && !lanes.empty())
+    {
+        const float spacing = ImGui::GetStyle().ItemSpacing.y;
+
+        // lanes fill the view when there are only a few of them, otherwise the view scrolls
+        const float lane_height =
+            std::max(LANE_MIN_HEIGHT, (ImGui::GetContentRegionAvail().y + spacing) / lanes.size() - spacing);
+
+        // only the lanes in view are submitted to ImPlot
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(lanes.size()), lane_height + spacing);
+
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+            {
+                const int ch_id   = lanes[i];
+                Channel&  channel = data[ch_id];
+
+                ImGui::PushID(ch_id);
+
+                if (ImPlot::BeginPlot("##lane", ImVec2(-1, lane_height)))
+                {
+                    // time labels only under the last lane
+                    const bool last_lane = (i == static_cast<int>(lanes.size()) - 1);
 
-                        plot_functions[plot_attributes[ch_id].combobox_func_index].func(label.c_str(),
-                                                                                        times->data(),
-                                                                                        values_transformed.data(),
-                                                                                        times->size(),
-                                                                                        0,
-                                                                                        0,
-                                                                                        sizeof(double));
-                        ImPlot::PopStyleColor(4);
+                    ImPlot::SetupAxis(
+                        ImAxis_X1, last_lane ? "Time" : nullptr, last_lane ? 0 : ImPlotAxisFlags_NoTickLabels);
+                    ImPlot::SetupAxis(ImAxis_Y1, "##Data");
+                    ImPlot::SetupAxisLinks(ImAxis_X1, &lanes_x_min, &lanes_x_max);
+
+                    if (plot_style.time_style == DATETIME)
+                    {
+                        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Time);
                     }
+
+                    ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_NoButtons);
+
+                    if (app_state == READING)
+                    {
+                        fit_y_axis(channel_extents(channel, times, first));
+                    }
+
+                    plot_channel(ch_id, channel, times, prepared);
+
+                    ImPlot::EndPlot();
                 }
 
-                ImPlot::EndPlot();
+                ImGui::PopID();
+            }
+        }
+    }
+    ImGui::EndChild();
+
+    // every lane has its own Y axis, so only the time window is used when saving the plot
+    plot_style.limits = {lanes_x_min,
+                         lanes_x_max,
+                         -std::numeric_limits<double>::infinity(),
+                         std::numeric_limits<double>::infinity()};
+}
+
+void LP::PlotView::render_persistence(const std::unordered_map<int, Channel>& data,
+                                      const std::vector<double>&              times,
+                                      const app_state_t                       app_state,
+                                      const double                            sweep_length,
+                                      const ImVec2                            size)
+{
+    std::vector<std::pair<int, ImVec4>> channels;
+
+    for (const auto& ch_id : data | std::views::keys)
+    {
+        if (plot_attributes[ch_id].show)
+            channels.emplace_back(ch_id, plot_attributes[ch_id].color);
+    }
+
+    std::ranges::sort(channels, {}, &std::pair<int, ImVec4>::first);
+
+    // only the samples received since the last frame are drawn
+    persistence.update(data, times, channels, sweep_length, plot_style.time_style);
+
+    if (ImPlot::BeginPlot("##persistence", size))
+    {
+        ImPlot::SetupAxis(ImAxis_X1, (plot_style.time_style == ELAPSED) ? "Sweep time (ms)" : "Sweep time (s)");
+        ImPlot::SetupAxis(ImAxis_Y1, "##Data");
+
+        // like a scope screen, the view is fixed while reading
+        ImPlot::SetupAxesLimits(0,
+                                persistence.get_sweep_length(),
+                                persistence.get_y_min(),
+                                persistence.get_y_max(),
+                                (app_state == READING) ? ImGuiCond_Always : ImGuiCond_Once);
+
+        persistence.plot();
+
+        ImPlot::EndPlot();
+    }
+}
+
+void LP::PlotView::render_spectrogram(const int ch_id, const Channel& channel, const std::vector<double>& times)
+{
+    // only the samples received since the last frame are handed to the worker
+    spectrogram.update(ch_id, channel, times, plot_style.time_style);
+
+    if (!ImPlot::BeginPlot("##spectrogram", ImVec2(-1, SPECTROGRAM_HEIGHT)))
+        return;
+
+    // the time axis follows the plot above
+    ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_NoTickLabels);
+    ImPlot::SetupAxis(ImAxis_Y1, "Hz");
+    ImPlot::SetupAxisLimits(ImAxis_X1, plot_style.limits.x_min, plot_style.limits.x_max, ImGuiCond_Always);
+    ImPlot::SetupAxisLimits(ImAxis_Y1, 0, std::max(spectrogram.get_nyquist(), 1.0), ImGuiCond_Always);
+
+    if (plot_style.time_style == DATETIME)
+    {
+        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Time);
+    }
+
+    spectrogram.plot();
+
+    ImPlot::EndPlot();
+}
+
+void LP::PlotView::render_overview(std::unordered_map<int, Channel>& data,
+                                   const std::vector<double>&        times,
+                                   const app_state_t                 app_state)
+{
+    if (!ImPlot::BeginPlot("##overview", ImVec2(-1, OVERVIEW_HEIGHT), ImPlotFlags_CanvasOnly))
+        return;
+
+    // the overview always shows the whole capture, it can't be panned or zoomed in time
+    ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_Lock);
+    ImPlot::SetupAxis(ImAxis_Y1, nullptr, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_AutoFit);
+    ImPlot::SetupAxisLimits(ImAxis_X1, times.front(), times.back(), ImGuiCond_Always);
+
+    if (plot_style.time_style == DATETIME)
+    {
+        ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Time);
+    }
+
+    std::vector<double> xs;
+    std::vector<double> mins;
+    std::vector<double> maxs;
+
+    for (auto& [ch_id, channel] : data)
+    {
+        if (!plot_attributes[ch_id].show)
+            continue;
+
+        const size_t n = std::min(channel.values.size(), times.size());
+
+        xs.clear();
+        mins.clear();
+        maxs.clear();
+
+        if (n <= OVERVIEW_BUCKETS)
+        {
+            // short captures are drawn as they are
+            for (size_t i = 0; i < n; i++)
+            {
+                xs.push_back(times[i]);
+                mins.push_back(channel.values[i] * channel.scale + channel.offset);
             }
+
+            maxs = mins;
         }
         else
         {
-            ImPlot::BeginPlot("##plot_win", ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y));
-            ImPlot::EndPlot();
+            // min/max buckets from the channel range index, whose count doesn't depend on the capture length
+            size_t      block_size = 0;
+            const auto& buckets    = channel.extents.level(OVERVIEW_BUCKETS, block_size);
+
+            for (size_t k = 0; k < buckets.size() && k * block_size < n; k++)
+            {
+                const double lo = buckets[k].valid() ? buckets[k].min * channel.scale + channel.offset : NAN;
+                const double hi = buckets[k].valid() ? buckets[k].max * channel.scale + channel.offset : NAN;
+
+                xs.push_back(times[std::min(k * block_size + block_size / 2, n - 1)]);
+                mins.push_back(std::min(lo, hi));
+                maxs.push_back(std::max(lo, hi));
+            }
         }
 
-        ImGui::End();
+        const std::string label = std::format("##overview{}", ch_id);
+
+        ImPlot::SetNextLineStyle(plot_attributes[ch_id].color);
+        ImPlot::PlotLine(label.c_str(), xs.data(), maxs.data(), static_cast<int>(xs.size()));
+        ImPlot::SetNextFillStyle(plot_attributes[ch_id].color, 0.5f);
+        ImPlot::PlotShaded(label.c_str(), xs.data(), mins.data(), maxs.data(), static_cast<int>(xs.size()));
+    }
+
+    // the main view, which can be moved and resized
+    const ImPlotRect limits = ImPlot::GetPlotLimits();
+
+    double x_min = plot_style.limits.x_min;
+    double x_max = plot_style.limits.x_max;
+    double y_min = limits.Y.Min;
+    double y_max = limits.Y.Max;
+
+    // while reading the main view follows the time window
+    ImPlotDragToolFlags flags = ImPlotDragToolFlags_NoFit;
+
+    if (app_state == READING)
+    {
+        flags |= ImPlotDragToolFlags_NoInputs;
+    }
+
+    if (ImPlot::DragRect(0, &x_min, &y_min, &x_max, &y_max, ImVec4(1.0f, 1.0f, 1.0f, 0.8f), flags))
+    {
+        view_x_min   = std::min(x_min, x_max);
+        view_x_max   = std::max(x_min, x_max);
+        view_request = true;
+    }
+
+    ImPlot::EndPlot();
+}
+
+void LP::PlotView::plot_channel(const int                  ch_id,
+                                const Channel&             channel,
+                                const std::vector<double>& times,
+                                const PreparedFrame*       prepared)
+{
+    std::string label = std::format("{}##{}", channel.name, ch_id);
+
+    ImPlot::PushStyleColor(ImPlotCol_Line, plot_attributes[ch_id].color);
+    ImPlot::PushStyleColor(ImPlotCol_MarkerOutline, plot_attributes[ch_id].color);
+    ImPlot::PushStyleColor(ImPlotCol_MarkerFill, plot_attributes[ch_id].color);
+    ImPlot::PushStyleColor(ImPlotCol_Fill, plot_attributes[ch_id].color);
+
+    if (plot_attributes[ch_id].bits > 0)
+    {
+        plot_bits(ch_id, channel, times);
+        ImPlot::PopStyleColor(4);
+        return;
+    }
+
+    const PlotFunc func = plot_functions[plot_attributes[ch_id].combobox_func_index].func;
+
+    const PreparedChannel* points = nullptr;
+
+    if (prepared != nullptr)
+    {
+        if (const auto it = prepared->channels.find(ch_id); it != prepared->channels.end())
+            points = &it->second;
+    }
+
+    if (points != nullptr)
+    {
+        const int count = static_cast<int>(points->xs.size());
+
+        func(label.c_str(), points->xs.data(), points->ys.data(), count, 0, 0, sizeof(double));
+    }
+    else
+    {
+        // nothing prepared for this view yet, plot every sample
+        std::vector<double> values_transformed;
+
+        values_transformed.reserve(channel.values.size());
+        for (size_t i = 0; i < channel.values.size(); ++i)
+        {
+            values_transformed.push_back(channel.values[i] * channel.scale + channel.offset);
+        }
+
+        func(label.c_str(), times.data(), values_transformed.data(), times.size(), 0, 0, sizeof(double));
+    }
+
+    ImPlot::PopStyleColor(4);
+}
+
+void LP::PlotView::plot_bits(const int ch_id, const Channel& channel, const std::vector<double>& times)
+{
+    const size_t n = std::min(channel.values.size(), times.size());
+
+    if (n == 0 || channel.runs.empty())
+        return;
+
+    // samples in view, plus one on each side
+    const ImPlotRect limits = ImPlot::GetPlotLimits();
+
+    size_t first = std::lower_bound(times.begin(), times.begin() + n, limits.X.Min) - times.begin();
+    size_t last  = std::upper_bound(times.begin() + first, times.begin() + n, limits.X.Max) - times.begin();
+
+    first = (first > 0) ? first - 1 : 0;
+    last  = std::min(last + 1, n);
+
+    // the run containing the first sample
+    const auto runs_begin =
+        std::prev(std::upper_bound(channel.runs.begin(),
+                                   channel.runs.end(),
+                                   first,
+                                   [](const size_t index, const ValueRun& run) { return index < run.first; }));
+
+    std::vector<double> xs;
+    std::vector<double> ys;
+
+    // most significant bit on top: ImPlot stacks digital items from the bottom, in submission order
+    for (int bit = plot_attributes[ch_id].bits - 1; bit >= 0; bit--)
+    {
+        xs.clear();
+        ys.clear();
+
+        // one point per transition of this bit
+        for (auto run = runs_begin; run != channel.runs.end() && run->first < last; ++run)
+        {
+            const double state =
+                std::isnan(run->value) ? 0.0 : static_cast<double>((std::llround(run->value) >> bit) & 1);
+
+            if (!ys.empty() && ys.back() == state)
+                continue;
+
+            xs.push_back(times[std::max(run->first, first)]);
+            ys.push_back(state);
+        }
+
+        // hold the last state up to the last sample
+        xs.push_back(times[last - 1]);
+        ys.push_back(ys.back());
+
+        const std::string label = std::format("{}[{}]##{}_{}", channel.name, bit, ch_id, bit);
+
+        ImPlot::PlotDigital(label.c_str(), xs.data(), ys.data(), static_cast<int>(xs.size()));
+    }
+}
+
+LP::Limits
+LP::PlotView::current_view(const app_state_t app_state, const double window_start, const double last_time) const
+{
+    if (app_state == READING)
+    {
+        return {window_start, last_time, 0, 0};
+    }
+
+    if (view_request)
+    {
+        return {view_x_min, view_x_max, 0, 0};
+    }
+
+    if (plot_style.strip_chart)
+    {
+        return {lanes_x_min, lanes_x_max, 0, 0};
+    }
+
+    return plot_style.limits;
+}
+
+void LP::PlotView::post_prep_request(GeometryPrep&                           prep,
+                                     const std::unordered_map<int, Channel>& data,
+                                     const Limits&                           view,
+                                     const float                             plot_width,
+                                     const size_t                            samples)
+{
+    PrepRequest req;
+
+    req.x_min      = view.x_min;
+    req.x_max      = view.x_max;
+    req.width      = static_cast<int>(plot_width);
+    req.time_style = plot_style.time_style;
+
+    // bitfields are drawn from their value runs
+    for (const auto& [ch_id, channel] : data)
+    {
+        if (plot_attributes[ch_id].show && plot_attributes[ch_id].bits == 0)
+        {
+            req.channels.push_back({ch_id, channel.scale, channel.offset});
+        }
+    }
+
+    // same order every frame, so that an unchanged view compares equal
+    std::ranges::sort(req.channels, {}, &PrepChannel::ch_id);
+
+    prep.post(req, samples);
+}
+
+LP::Extents LP::PlotView::channel_extents(const Channel& channel, const std::vector<double>& times, const size_t first)
+{
+    const size_t  n     = std::min(channel.values.size(), times.size());
+    const Extents range = channel.extents.query(channel.values, std::min(first, n), n);
+
+    Extents result;
+
+    if (range.valid())
+    {
+        result.extend(range.min * channel.scale + channel.offset);
+        result.extend(range.max * channel.scale + channel.offset);
+    }
+
+    return result;
+}
+
+void LP::PlotView::fit_y_axis(const Extents& extents)
+{
+    if (extents.valid())
+    {
+        // same padding ImPlot applies to a flat series
+        const double pad = (extents.min == extents.max) ? 0.5 : 0.0;
+
+        ImPlot::SetupAxisLimits(ImAxis_Y1, extents.min - pad, extents.max + pad, ImGuiCond_Always);
     }
 }
 
@@ -130,83 +631,104 @@ void LP::PlotView::render_telemetry(Telemetry& tel)
             ImGui::TableSetupColumn("Button", ImGuiTableColumnFlags_WidthFixed, 50.0f);
 
             std::lock_guard<std::mutex> lock(tel.get_data_mtx());
-            for (auto& [ch_id, channel] : *tel.get_data())
+            auto*                       data = tel.get_data();
+
+            // channels are only added, or all removed at once
+            if (table_rows.size() != data->size())
             {
-                if (!plot_attributes.contains(ch_id))
+                table_rows.clear();
+
+                for (const auto& ch_id : *data | std::views::keys)
                 {
-                    channel_style_init(ch_id);
+                    table_rows.push_back(ch_id);
                 }
 
-                ImGui::TableNextRow();
-                ImGui::TableNextColumn();
+                std::ranges::sort(table_rows);
+            }
+
+            // only the visible rows are submitted
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(table_rows.size()));
 
-                ImGui::PushID(ch_id);
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    const int ch_id   = table_rows[row];
+                    Channel&  channel = (*data)[ch_id];
+
+                    if (!plot_attributes.contains(ch_id))
+                    {
+                        channel_style_init(ch_id);
+                    }
 
-                float selected_color[4] = {plot_attributes[ch_id].color.x,
-                                           plot_attributes[ch_id].color.y,
-                                           plot_attributes[ch_id].color.z,
-                                           plot_attributes[ch_id].color.w};
-                ImGui::ColorEdit4("##Color", selected_color, ImGuiColorEditFlags_NoInputs);
-                plot_attributes[ch_id].color = {
-                    selected_color[0], selected_color[1], selected_color[2], selected_color[3]};
+                    ChannelStyle& style = plot_attributes[ch_id];
 
-                ImGui::SameLine();
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
 
-                // create the text buffer
-                char display_name_buffer[TEXT_BUFFER_SIZE];
-                std::strncpy(display_name_buffer, channel.name.c_str(), sizeof(display_name_buffer) - 1);
-                display_name_buffer[sizeof(display_name_buffer) - 1] = '\0';
+                    ImGui::PushID(ch_id);
 
-                ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
-                ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 0.0f);
+                    ImGui::ColorEdit4("##Color", &style.color.x, ImGuiColorEditFlags_NoInputs);
 
-                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
-                ImGui::InputText("##Name", display_name_buffer, sizeof(display_name_buffer));
-                channel.name = display_name_buffer;
+                    ImGui::SameLine();
 
-                // if the name is an empty string, assign the default name
-                if (channel.name.empty())
-                {
-                    channel.name = std::format("Data {}", ch_id);
-                }
+                    ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+                    ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 0.0f);
 
-                ImGui::PopStyleVar();
-                ImGui::PopStyleColor();
+                    // edit the name in place, the string grows as needed
+                    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+                    ImGui::InputText("##Name",
+                                     channel.name.data(),
+                                     channel.name.capacity() + 1,
+                                     ImGuiInputTextFlags_CallbackResize,
+                                     resize_string_callback,
+                                     &channel.name);
 
-                ImGui::TableNextColumn();
+                    // if the name is an empty string, assign the default name
+                    if (ImGui::IsItemDeactivatedAfterEdit() && channel.name.empty())
+                    {
+                        channel.name = std::format("Data {}", ch_id);
+                    }
 
-                if (!channel.values.empty())
-                {
-                    ImGui::Text("%.2f", channel.values.back() * channel.scale + channel.offset);
-                }
+                    ImGui::PopStyleVar();
+                    ImGui::PopStyleColor();
 
-                ImGui::TableNextColumn();
+                    ImGui::TableNextColumn();
 
-                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
-                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
-                ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
-                ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 0.0f);
-                ImGui::Button(ICON_LC_SETTINGS);
-                ImGui::PopStyleColor(3);
-                ImGui::PopStyleVar();
+                    if (!channel.values.empty())
+                    {
+                        ImGui::Text("%.2f", channel.values.back() * channel.scale + channel.offset);
+                    }
 
-                if (ImGui::IsItemClicked())
-                {
-                    ImGui::OpenPopup(("##ChannelConfig" + std::to_string(ch_id)).c_str());
-                }
+                    ImGui::TableNextColumn();
+
+                    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+                    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+                    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+                    ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 0.0f);
+                    ImGui::Button(ICON_LC_SETTINGS);
+                    ImGui::PopStyleColor(3);
+                    ImGui::PopStyleVar();
 
-                render_channel_settings(ch_id, channel, plot_attributes[ch_id]);
+                    // the popup ID is scoped by the channel ID pushed above
+                    if (ImGui::IsItemClicked())
+                    {
+                        ImGui::OpenPopup("##ChannelConfig");
+                    }
 
-                ImGui::TableNextColumn();
+                    render_channel_settings(ch_id, channel, style);
 
-                std::string bt_id = std::format("{}", plot_attributes[ch_id].show ? "HIDE" : "SHOW");
-                if (ImGui::Button(bt_id.c_str()))
-                {
-                    plot_attributes[ch_id].show = !plot_attributes[ch_id].show;
-                    open                        = !open;
-                }
+                    ImGui::TableNextColumn();
 
-                ImGui::PopID();
+                    if (ImGui::Button(style.show ? "HIDE" : "SHOW"))
+                    {
+                        style.show = !style.show;
+                        open       = !open;
+                    }
+
+                    ImGui::PopID();
+                }
             }
 
             ImGui::EndTable();
@@ -280,6 +802,49 @@ void LP::PlotView::render_plot_options()
             plot_style.time_style = ELAPSED;
         }
 
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        ImGui::Checkbox("Strip chart", &plot_style.strip_chart);
+
+        ImGui::TableNextColumn();
+
+        render_tooltip("Draw every channel in its own lane, with its own Y axis and a shared time axis");
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        if (ImGui::Checkbox("Persistence", &plot_style.persistence))
+        {
+            persistence.reset();
+        }
+
+        ImGui::TableNextColumn();
+
+        render_tooltip("Overlay the sweeps of the channels like an oscilloscope screen, fading at every new sweep. "
+                       "A sweep lasts one time window.");
+
+        if (plot_style.persistence)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+
+            ImGui::Text("Decay");
+
+            ImGui::TableNextColumn();
+
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - ImGui::CalcTextSize("Reset").x -
+                                    ImGui::GetStyle().FramePadding.x * 2 - ImGui::GetStyle().ItemSpacing.x);
+            ImGui::SliderFloat("##decay", &persistence.decay, 0.0f, 0.99f, "%.2f");
+
+            ImGui::SameLine();
+
+            if (ImGui::Button("Reset"))
+            {
+                persistence.reset();
+            }
+        }
+
         ImGui::EndTable();
     }
 }
@@ -291,9 +856,9 @@ void LP::PlotView::channel_style_init(int id)
                            .show  = true};
 }
 
-void LP::PlotView::render_channel_settings(int id, Channel& data, ChannelStyle& style)
+void LP::PlotView::render_channel_settings(const int ch_id, Channel& data, ChannelStyle& style)
 {
-    if (ImGui::BeginPopup(("##ChannelConfig" + std::to_string(id)).c_str()))
+    if (ImGui::BeginPopup("##ChannelConfig"))
     {
         ImGui::Text("Channel '%s'", data.name.c_str());
         ImGui::Separator();
@@ -347,6 +912,40 @@ void LP::PlotView::render_channel_settings(int id, Channel& data, ChannelStyle&
                 ImGui::EndCombo();
             }
 
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+
+            // status words, drawn as one digital lane per bit
+            ImGui::Text("Bitfield: ");
+
+            ImGui::TableNextColumn();
+
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+            if (ImGui::InputInt("##bits", &style.bits))
+            {
+                style.bits = std::clamp(style.bits, 0, 32);
+            }
+
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Number of bits to show as digital lanes, 0 to plot the value");
+            }
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+
+            ImGui::Text("Spectrogram: ");
+
+            ImGui::TableNextColumn();
+
+            // a single channel at a time
+            bool spectrogram_shown = plot_style.spectrogram_channel == ch_id;
+
+            if (ImGui::Checkbox("##Spectrogram", &spectrogram_shown))
+            {
+                plot_style.spectrogram_channel = spectrogram_shown ? ch_id : 0;
+            }
+
             ImGui::EndTable();
         }
 
@@ -552,6 +1151,19 @@ void LP::PlotView::render_data_format(Telemetry& tel, app_state_t app_state)
     }
 }
 
+int LP::PlotView::resize_string_callback(ImGuiInputTextCallbackData* data)
+{
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+    {
+        auto* str = static_cast<std::string*>(data->UserData);
+
+        str->resize(data->BufTextLen);
+        data->Buf = str->data();
+    }
+
+    return 0;
+}
+
 void LP::PlotView::render_tooltip(const char* message)
 {
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
@@ -575,6 +1187,7 @@ void LP::PlotView::render_tooltip(const char* message)
 
 const std::array<LP::plot_functions_t, PLOT_FUNC_SIZE> LP::plot_functions = {{
     {"Line", ImPlot::PlotLine<double>},
-    {"Scatter", ImPlot::PlotScatter<double>},
+    {"Scatter", LP::GpuPlot::plot_scatter},
     {"Shaded", ImPlot::PlotShaded<double>},
+    {"Line (fast)", LP::GpuPlot::plot_line},
 }};
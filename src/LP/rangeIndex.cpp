@@ -0,0 +1,136 @@
+#include <LP/rangeIndex.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+void LP::RangeIndex::push(const double value)
+{
+    size_t entry = count / RANGE_INDEX_BLOCK_SIZE;
+    count++;
+
+    if (levels.empty())
+    {
+        levels.emplace_back();
+    }
+
+    // propagate the value from its block up to the top of the pyramid, which always has a single entry
+    for (size_t level = 0; level == 0 || levels[level - 1].size() > 1; level++, entry /= 2)
+    {
+        if (levels.size() <= level)
+        {
+            // new top level: summarise the level below, which already accounts for the value
+            std::vector<Extents> top((levels[level - 1].size() + 1) / 2);
+
+            for (size_t i = 0; i < levels[level - 1].size(); i++)
+            {
+                top[i / 2].merge(levels[level - 1][i]);
+            }
+
+            levels.push_back(std::move(top));
+            continue;
+        }
+
+        if (levels[level].size() <= entry)
+        {
+            levels[level].emplace_back();
+        }
+
+        levels[level][entry].extend(value);
+    }
+}
+
+void LP::RangeIndex::build(const std::vector<double>& values)
+{
+    clear();
+
+    for (const double value : values)
+    {
+        push(value);
+    }
+}
+
+LP::Extents LP::RangeIndex::query(const std::vector<double>& values, size_t first, size_t last) const
+{
+    Extents result;
+
+    last = std::min({last, count, values.size()});
+
+    if (first >= last)
+    {
+        return result;
+    }
+
+    // indices of the first and past the last whole blocks in the range
+    size_t block_first = (first + RANGE_INDEX_BLOCK_SIZE - 1) / RANGE_INDEX_BLOCK_SIZE;
+    size_t block_last  = last / RANGE_INDEX_BLOCK_SIZE;
+
+    // the range doesn't contain any whole block
+    if (block_first >= block_last)
+    {
+        scan(values, first, last, result);
+        return result;
+    }
+
+    // partial blocks at the edges
+    scan(values, first, block_first * RANGE_INDEX_BLOCK_SIZE, result);
+    scan(values, block_last * RANGE_INDEX_BLOCK_SIZE, last, result);
+
+    // whole blocks, climbing the pyramid
+    for (size_t level = 0; level < levels.size() && block_first < block_last; level++)
+    {
+        if (block_first % 2 == 1)
+        {
+            result.merge(levels[level][block_first++]);
+        }
+
+        if (block_last % 2 == 1)
+        {
+            result.merge(levels[level][--block_last]);
+        }
+
+        block_first /= 2;
+        block_last /= 2;
+    }
+
+    return result;
+}
+
+LP::Extents LP::RangeIndex::total() const
+{
+    return levels.empty() ? Extents() : levels.back().front();
+}
+
+const std::vector<LP::Extents>& LP::RangeIndex::level(const size_t max_entries, size_t& block_size) const
+{
+    static const std::vector<Extents> empty;
+
+    block_size = RANGE_INDEX_BLOCK_SIZE;
+
+    for (const auto& entries : levels)
+    {
+        if (entries.size() <= max_entries)
+        {
+            return entries;
+        }
+
+        block_size *= 2;
+    }
+
+    // only reached if the index is empty or max_entries is 0, the top level has a single entry
+    block_size = RANGE_INDEX_BLOCK_SIZE;
+    return empty;
+}
+
+void LP::RangeIndex::clear()
+{
+    levels.clear();
+    count = 0;
+}
+
+void LP::RangeIndex::scan(const std::vector<double>& values, const size_t first, const size_t last, Extents& result)
+{
+    for (size_t i = first; i < last; i++)
+    {
+        result.extend(values[i]);
+    }
+}
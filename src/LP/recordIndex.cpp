@@ -0,0 +1,182 @@
+#include <LP/recordIndex.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+    // split a base path into its stem and its extension, `.csv.gz` included
+    std::pair<std::string, std::string> split_extension(const std::string& base_path)
+    {
+        const std::filesystem::path path(base_path);
+
+        std::filesystem::path stem      = path.stem();
+        std::string           extension = path.extension().string();
+
+        if (extension == ".gz" && stem.has_extension())
+        {
+            extension = stem.extension().string() + extension;
+            stem      = stem.stem();
+        }
+
+        return {(path.parent_path() / stem).string(), extension};
+    }
+
+    bool parse_double(const std::string_view field, double& value)
+    {
+        return std::from_chars(field.data(), field.data() + field.size(), value).ec == std::errc();
+    }
+}
+
+bool LP::RecordIndex::load(const std::string& path)
+{
+    std::ifstream file(path);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+
+    if (!std::getline(file, line) || !line.starts_with("LPIDX;"))
+    {
+        return false;
+    }
+
+    const std::string_view header(line);
+    const size_t           style = header.rfind(';');
+
+    if (header.substr(6, style - 6) != std::to_string(RECORD_INDEX_VERSION))
+    {
+        return false;
+    }
+
+    time_style = (header.substr(style + 1) == "DATETIME") ? DATETIME : ELAPSED;
+    directory  = std::filesystem::path(path).parent_path().string();
+
+    segments.clear();
+
+    while (std::getline(file, line))
+    {
+        if (line.empty())
+            continue;
+
+        // the name may hold ';', the three numbers are taken from the end
+        std::string_view fields[4];
+        std::string_view rest = line;
+
+        for (int i = 3; i > 0; i--)
+        {
+            const size_t sep = rest.rfind(';');
+
+            if (sep == std::string_view::npos)
+                return false;
+
+            fields[i] = rest.substr(sep + 1);
+            rest      = rest.substr(0, sep);
+        }
+
+        fields[0] = rest;
+
+        RecordSegment segment = {std::string(fields[0]), NAN, NAN, 0};
+        double        rows    = 0;
+
+        // empty times are those of a file without rows yet
+        if ((!fields[1].empty() && !parse_double(fields[1], segment.first)) ||
+            (!fields[2].empty() && !parse_double(fields[2], segment.last)) || !parse_double(fields[3], rows))
+        {
+            return false;
+        }
+
+        segment.rows = static_cast<size_t>(rows);
+        segments.push_back(std::move(segment));
+    }
+
+    return true;
+}
+
+bool LP::RecordIndex::save(const std::string& path) const
+{
+    const std::string temp_path = path + ".tmp";
+
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file << "LPIDX;" << RECORD_INDEX_VERSION << ';' << ((time_style == DATETIME) ? "DATETIME" : "ELAPSED")
+             << '\n';
+
+        const auto format_time = [](const double time) { return std::isnan(time) ? "" : std::format("{}", time); };
+
+        for (const RecordSegment& segment : segments)
+        {
+            file << segment.file << ';' << format_time(segment.first) << ';' << format_time(segment.last) << ';'
+                 << segment.rows << '\n';
+        }
+
+        file.close();
+
+        if (file.fail())
+        {
+            return false;
+        }
+    }
+
+    // rename replaces the old index in one step
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+
+    return !ec;
+}
+
+size_t LP::RecordIndex::find(const double time) const
+{
+    // the first segment that doesn't end before `time`; files without rows end nowhere
+    const auto segment = std::ranges::find_if(segments,
+                                              [time](const RecordSegment& s)
+                                              { return s.rows > 0 && s.last >= time; });
+
+    return segment - segments.begin();
+}
+
+std::pair<size_t, size_t> LP::RecordIndex::find_range(const double from, const double to) const
+{
+    const size_t first = find(from);
+    size_t       last  = first;
+
+    while (last < segments.size() && (segments[last].rows == 0 || segments[last].first <= to))
+    {
+        last++;
+    }
+
+    return {first, last};
+}
+
+std::string LP::RecordIndex::get_path(const size_t segment) const
+{
+    return (std::filesystem::path(directory) / segments[segment].file).string();
+}
+
+std::string LP::RecordIndex::index_path(const std::string& base_path)
+{
+    return split_extension(base_path).first + ".lpidx";
+}
+
+std::string LP::RecordIndex::segment_path(const std::string& base_path, const size_t number)
+{
+    const auto [stem, extension] = split_extension(base_path);
+
+    return std::format("{}_{:04}{}", stem, number, extension);
+}
@@ -0,0 +1,387 @@
+#include <LP/csvFormat.h>
+#include <LP/recorder.h>
+#include <LP/telemetry.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+LP::Recorder::~Recorder()
+{
+    stop();
+}
+
+bool LP::Recorder::start(const Telemetry&    tel,
+                         const std::string&  file_path,
+                         const PlotTimeStyle ts,
+                         const int           sync_ms,
+                         const Rotation&     file_rotation)
+{
+    stop();
+
+    base_path      = file_path;
+    rotation       = file_rotation;
+    segment_number = 1;
+    segment_bytes  = 0;
+    segment_start  = std::chrono::steady_clock::now();
+
+    const std::string first_path = rotation.enabled() ? RecordIndex::segment_path(base_path, 1) : base_path;
+
+    if (!open_file(first_path))
+    {
+        std::cerr << "Error while opening record file." << std::endl;
+        return false;
+    }
+
+    if (rotation.enabled())
+    {
+        index = RecordIndex();
+        index.set_time_style(ts);
+        index.set_directory(std::filesystem::path(base_path).parent_path().string());
+        index.get_segments().push_back({std::filesystem::path(first_path).filename().string(), NAN, NAN, 0});
+        index.save(RecordIndex::index_path(base_path));
+    }
+
+    std::lock_guard data_lock(tel.get_data_mtx());
+    std::lock_guard lock(mtx);
+
+    channel_ids.clear();
+
+    pending            = Snapshot();
+    pending.time_style = ts;
+    time_style         = ts;
+    sync_interval_ms   = sync_ms;
+    running            = true;
+
+    // only the rows committed from now on
+    recorded = tel.get_unix_timestamps()->size();
+
+    active = true;
+    writer = std::thread(&Recorder::run, this);
+
+    return true;
+}
+
+void LP::Recorder::stop()
+{
+    active = false;
+
+    {
+        std::lock_guard lock(mtx);
+
+        if (!running)
+        {
+            return;
+        }
+
+        running = false;
+    }
+
+    cv.notify_one();
+
+    if (writer.joinable())
+    {
+        writer.join();
+    }
+}
+
+void LP::Recorder::commit(const Telemetry& tel)
+{
+    if (!active)
+    {
+        return;
+    }
+
+    std::lock_guard lock(mtx);
+
+    if (!running)
+    {
+        return;
+    }
+
+    const std::vector<double>& times =
+        (time_style == DATETIME) ? *tel.get_unix_timestamps() : *tel.get_elapsed_timestamps();
+
+    // the data was cleared, e.g. when another port was opened
+    if (times.size() < recorded)
+    {
+        recorded = 0;
+    }
+
+    if (times.size() == recorded)
+    {
+        return;
+    }
+
+    // the columns are fixed by the first rows
+    if (channel_ids.empty())
+    {
+        for (const int id : *tel.get_data() | std::views::keys)
+        {
+            channel_ids.push_back(id);
+        }
+
+        std::ranges::sort(channel_ids);
+
+        for (const int id : channel_ids)
+        {
+            pending.names.push_back(tel.get_data()->at(id).name);
+        }
+
+        pending.columns.resize(channel_ids.size());
+    }
+
+    pending.times.insert(pending.times.end(), times.begin() + recorded, times.end());
+
+    for (size_t c = 0; c < channel_ids.size(); c++)
+    {
+        const auto channel = tel.get_data()->find(channel_ids[c]);
+
+        for (size_t i = recorded; i < times.size(); i++)
+        {
+            if (channel != tel.get_data()->end() && i < channel->second.values.size())
+            {
+                pending.columns[c].push_back(channel->second.values[i] * channel->second.scale +
+                                             channel->second.offset);
+            }
+            else
+            {
+                pending.columns[c].push_back(std::nan(""));
+            }
+        }
+    }
+
+    recorded = times.size();
+}
+
+void LP::Recorder::set_sync_interval(const int interval_ms)
+{
+    std::lock_guard lock(mtx);
+
+    sync_interval_ms = interval_ms;
+}
+
+void LP::Recorder::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    CsvFormatter formatter;
+    std::string  buffer;
+    Snapshot     batch;
+    bool         header_written = false;
+    bool         failed         = false;
+    int          sync_ms        = -1;
+    auto         last_sync      = clock::now();
+
+    while (true)
+    {
+        bool stopping;
+
+        {
+            std::unique_lock lock(mtx);
+            cv.wait_for(lock, std::chrono::milliseconds(RECORDER_WRITE_INTERVAL_MS), [this]() { return !running; });
+
+            stopping = !running;
+            sync_ms  = sync_interval_ms;
+
+            // take the pending rows, and leave the emptied buffers to be filled again
+            batch.time_style = time_style;
+            batch.names      = pending.names;
+            batch.columns.resize(pending.columns.size());
+
+            std::swap(batch.times, pending.times);
+
+            for (size_t c = 0; c < pending.columns.size(); c++)
+            {
+                std::swap(batch.columns[c], pending.columns[c]);
+            }
+        }
+
+        const bool sync_now =
+            sync_ms == 0 || (sync_ms > 0 && clock::now() - last_sync >= std::chrono::milliseconds(sync_ms));
+
+        // move on to the next file before this batch, once the current one is full or old enough
+        if (rotation.enabled() && !batch.times.empty() && index.get_segments().back().rows > 0 &&
+            ((rotation.max_bytes > 0 && segment_bytes >= rotation.max_bytes) ||
+             (rotation.interval_s > 0 && clock::now() - segment_start >= std::chrono::seconds(rotation.interval_s))))
+        {
+            if (!rotate(sync_ms >= 0))
+            {
+                std::cerr << "Error while creating the next record file, the recording is stopped." << std::endl;
+
+                active = false;
+                failed = true;
+                break;
+            }
+
+            header_written = false;
+        }
+
+        if (!header_written && !batch.names.empty())
+        {
+            CsvFormatter::append_header(buffer, batch);
+            header_written = true;
+        }
+
+        for (size_t row = 0; row < batch.times.size(); row++)
+        {
+            formatter.append_row(buffer, batch, row);
+        }
+
+        if (!buffer.empty())
+        {
+            segment_bytes += buffer.size();
+
+            // the compressor flushes, and syncs, once it has written the block
+            const bool written =
+                gzip.is_open() ? gzip.write(buffer, true, sync_now)
+                               : std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() &&
+                                     std::fflush(file) == 0;
+
+            if (!written)
+            {
+                std::cerr << "Error while writing record file, the recording is stopped." << std::endl;
+
+                // the rows committed from now on are dropped, until `stop` joins the writer
+                active = false;
+                failed = true;
+                break;
+            }
+
+            if (sync_now)
+            {
+                if (file != nullptr)
+                    sync();
+
+                last_sync = clock::now();
+            }
+        }
+
+        if (rotation.enabled() && !batch.times.empty())
+        {
+            RecordSegment& segment = index.get_segments().back();
+
+            if (segment.rows == 0)
+                segment.first = batch.times.front();
+
+            segment.last  = batch.times.back();
+            segment.rows += batch.times.size();
+
+            // saved with every write, so that after a crash the index still covers the rows on the disk
+            index.save(RecordIndex::index_path(base_path));
+        }
+
+        buffer.clear();
+        batch.times.clear();
+
+        for (auto& column : batch.columns)
+        {
+            column.clear();
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+    }
+
+    close_file(sync_ms >= 0 && !failed);
+
+    if (rotation.enabled())
+    {
+        index.save(RecordIndex::index_path(base_path));
+    }
+}
+
+bool LP::Recorder::open_file(const std::string& path)
+{
+    if (GzipWriter::is_gzip_path(path))
+    {
+        return gzip.open(path);
+    }
+
+    file = std::fopen(path.c_str(), "w");
+
+    return file != nullptr;
+}
+
+bool LP::Recorder::close_file(const bool sync_file)
+{
+    if (gzip.is_open())
+    {
+        return gzip.close();
+    }
+
+    if (file == nullptr)
+    {
+        return true;
+    }
+
+    if (sync_file)
+    {
+        sync();
+    }
+
+    const bool closed = std::fclose(file) == 0;
+    file              = nullptr;
+
+    return closed;
+}
+
+bool LP::Recorder::rotate(const bool sync_file)
+{
+    close_file(sync_file);
+
+    segment_number++;
+    segment_bytes = 0;
+    segment_start = std::chrono::steady_clock::now();
+
+    const std::string path = RecordIndex::segment_path(base_path, segment_number);
+
+    if (!open_file(path))
+    {
+        index.save(RecordIndex::index_path(base_path));
+        return false;
+    }
+
+    std::vector<RecordSegment>& segments = index.get_segments();
+
+    segments.push_back({std::filesystem::path(path).filename().string(), NAN, NAN, 0});
+
+    // the oldest files go first, so that the set never holds more than `max_files`
+    while (rotation.max_files > 0 && segments.size() > rotation.max_files)
+    {
+        std::error_code ec;
+        std::filesystem::remove(index.get_path(0), ec);
+
+        segments.erase(segments.begin());
+    }
+
+    index.save(RecordIndex::index_path(base_path));
+
+    return true;
+}
+
+void LP::Recorder::sync() const
+{
+#ifndef _WIN32
+    fsync(fileno(file));
+#else
+    _commit(_fileno(file));
+#endif
+}
@@ -0,0 +1,290 @@
+#include <LP/fft.h>
+#include <LP/spectrogram.h>
+#include <algorithm>
+#include <complex>
+#include <glad/glad.h>
+#include <imgui.h>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../implot/implot.h"
+
+// samples still worth computing when (re)starting: enough to fill the whole history
+#define SPECTROGRAM_HISTORY (SPECTROGRAM_COLUMNS * SPECTROGRAM_HOP + SPECTROGRAM_FFT_SIZE)
+
+LP::Spectrogram::~Spectrogram()
+{
+    stop();
+}
+
+void LP::Spectrogram::update(const int                  id,
+                             const Channel&             channel,
+                             const std::vector<double>& times,
+                             const PlotTimeStyle        ts)
+{
+    {
+        std::lock_guard lock(mtx);
+
+        if (!running)
+        {
+            running = true;
+            worker  = std::thread(&Spectrogram::run, this);
+        }
+    }
+
+    const size_t n = std::min(channel.values.size(), times.size());
+
+    if (id != ch_id || channel.scale != scale || ts != time_style || n < fed)
+    {
+        ch_id      = id;
+        scale      = channel.scale;
+        time_style = ts;
+
+        restart();
+
+        fed = (n > SPECTROGRAM_HISTORY) ? n - SPECTROGRAM_HISTORY : 0;
+    }
+
+    // the offset only moves the DC bin, so only the scale is applied
+    if (n > fed)
+    {
+        std::lock_guard lock(mtx);
+
+        for (size_t i = fed; i < n; i++)
+        {
+            input_values.push_back(channel.values[i] * scale);
+            input_times.push_back(times[i]);
+        }
+
+        fed = n;
+        cv.notify_one();
+    }
+
+    std::vector<float>  columns;
+    std::vector<double> columns_times;
+
+    {
+        std::lock_guard lock(mtx);
+        std::swap(columns, ready_columns);
+        std::swap(columns_times, ready_times);
+    }
+
+    for (size_t c = 0; c < columns_times.size(); c++)
+    {
+        upload_column(columns.data() + c * SPECTROGRAM_BINS, columns_times[c]);
+    }
+}
+
+void LP::Spectrogram::run()
+{
+    // samples not yet covered by a whole column
+    std::vector<double> values;
+    std::vector<double> times;
+    size_t              current = 0;
+
+    std::vector<std::complex<double>> work;
+    std::vector<float>                columns;
+    std::vector<double>               columns_times;
+
+    while (true)
+    {
+        std::vector<double> new_values;
+        std::vector<double> new_times;
+        size_t              gen;
+
+        {
+            std::unique_lock lock(mtx);
+            cv.wait(lock, [this]() { return !input_values.empty() || !running; });
+
+            if (!running)
+            {
+                return;
+            }
+
+            std::swap(new_values, input_values);
+            std::swap(new_times, input_times);
+            gen = generation;
+        }
+
+        if (gen != current)
+        {
+            values.clear();
+            times.clear();
+            current = gen;
+        }
+
+        values.insert(values.end(), new_values.begin(), new_values.end());
+        times.insert(times.end(), new_times.begin(), new_times.end());
+
+        columns.clear();
+        columns_times.clear();
+
+        size_t start = 0;
+
+        for (; values.size() - start >= SPECTROGRAM_FFT_SIZE; start += SPECTROGRAM_HOP)
+        {
+            columns.resize(columns.size() + SPECTROGRAM_BINS);
+
+            float* column = columns.data() + columns.size() - SPECTROGRAM_BINS;
+            FFT::power_db(values.data() + start, SPECTROGRAM_FFT_SIZE, column, work);
+
+            columns_times.push_back(times[start + SPECTROGRAM_FFT_SIZE - 1]);
+        }
+
+        values.erase(values.begin(), values.begin() + start);
+        times.erase(times.begin(), times.begin() + start);
+
+        std::lock_guard lock(mtx);
+
+        // columns of a restarted spectrogram are dropped
+        if (gen == generation)
+        {
+            ready_columns.insert(ready_columns.end(), columns.begin(), columns.end());
+            ready_times.insert(ready_times.end(), columns_times.begin(), columns_times.end());
+        }
+    }
+}
+
+void LP::Spectrogram::stop()
+{
+    {
+        std::lock_guard lock(mtx);
+
+        if (!running)
+        {
+            return;
+        }
+
+        running = false;
+    }
+
+    cv.notify_one();
+
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void LP::Spectrogram::restart()
+{
+    {
+        std::lock_guard lock(mtx);
+
+        generation++;
+        input_values.clear();
+        input_times.clear();
+        ready_columns.clear();
+        ready_times.clear();
+    }
+
+    head        = 0;
+    filled      = 0;
+    peak_db     = -200.0f;
+    sample_rate = 0;
+}
+
+void LP::Spectrogram::init_texture()
+{
+    for (size_t i = 0; i < colormap.size(); i++)
+    {
+        colormap[i] = ImGui::GetColorU32(ImPlot::SampleColormap(i / 255.0f, ImPlotColormap_Viridis));
+    }
+
+    column_times.resize(SPECTROGRAM_COLUMNS);
+    column_pixels.resize(SPECTROGRAM_BINS);
+
+    GLint last_texture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+
+    // columns wrap around horizontally, so that the ring can be shown with a single offset image
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(
+        GL_TEXTURE_2D, 0, GL_RGBA, SPECTROGRAM_COLUMNS, SPECTROGRAM_BINS, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
+void LP::Spectrogram::upload_column(const float* power, const double time)
+{
+    if (texture == 0)
+    {
+        init_texture();
+    }
+
+    peak_db = std::max(peak_db, *std::max_element(power, power + SPECTROGRAM_BINS));
+
+    // highest frequencies on the top row
+    for (size_t k = 0; k < SPECTROGRAM_BINS; k++)
+    {
+        const float level =
+            std::clamp((power[k] - peak_db + SPECTROGRAM_RANGE_DB) / SPECTROGRAM_RANGE_DB, 0.0f, 1.0f);
+
+        column_pixels[SPECTROGRAM_BINS - 1 - k] = colormap[static_cast<size_t>(level * 255.0f)];
+    }
+
+    GLint last_texture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, head, 0, 1, SPECTROGRAM_BINS, GL_RGBA, GL_UNSIGNED_BYTE, column_pixels.data());
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+
+    // sample rate from the time between columns, smoothed against the timestamps jitter
+    if (filled > 0)
+    {
+        const double dt = (time - column_times[(head + SPECTROGRAM_COLUMNS - 1) % SPECTROGRAM_COLUMNS]) *
+                          ((time_style == ELAPSED) ? 1e-3 : 1.0);
+
+        if (dt > 0)
+        {
+            const double rate = SPECTROGRAM_HOP / dt;
+            sample_rate       = (sample_rate == 0) ? rate : sample_rate * 0.9 + rate * 0.1;
+        }
+    }
+
+    column_times[head] = time;
+    head               = (head + 1) % SPECTROGRAM_COLUMNS;
+    filled             = std::min<size_t>(filled + 1, SPECTROGRAM_COLUMNS);
+}
+
+void LP::Spectrogram::plot() const
+{
+    if (texture == 0 || filled < 2 || sample_rate <= 0)
+    {
+        return;
+    }
+
+    const size_t oldest = (filled < SPECTROGRAM_COLUMNS) ? 0 : head;
+    const size_t newest = (head + SPECTROGRAM_COLUMNS - 1) % SPECTROGRAM_COLUMNS;
+
+    // the texture repeats horizontally, so the ring is unrolled by the texture coordinates
+    const float u0 = static_cast<float>(oldest) / SPECTROGRAM_COLUMNS;
+    const float u1 = u0 + static_cast<float>(filled) / SPECTROGRAM_COLUMNS;
+
+    ImPlot::PlotImage("##spectrogram",
+                      ImTextureRef(static_cast<ImTextureID>(texture)),
+                      ImPlotPoint(column_times[oldest], 0),
+                      ImPlotPoint(column_times[newest], get_nyquist()),
+                      ImVec2(u0, 0),
+                      ImVec2(u1, 1));
+}
+
+void LP::Spectrogram::destroy()
+{
+    stop();
+
+    if (texture != 0)
+    {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
@@ -1,8 +1,12 @@
+#include <LP/csvFormat.h>
+#include <LP/gzipWriter.h>
 #include <LP/shared.h>
 #include <LP/telemetry.h>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <ctime>
 #include <format>
 #include <fstream>
@@ -10,13 +14,16 @@
 #include <iostream>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <ostream>
 #include <ranges>
 #include <regex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "LP/plotView.h"
@@ -66,6 +73,17 @@ std::string LP::Telemetry::parse_serial(std::vector<char>& buffer)
 }
 
 void LP::Telemetry::parse_frame(const std::string& frame_stream)
+{
+    parse_frames(frame_stream, std::nullopt);
+}
+
+void LP::Telemetry::parse_frame(const std::string& frame_stream, const double unix_time, const double elapsed_time)
+{
+    parse_frames(frame_stream, std::make_pair(unix_time, elapsed_time));
+}
+
+void LP::Telemetry::parse_frames(const std::string&                               frame_stream,
+                                 const std::optional<std::pair<double, double>>& times)
 {
     auto it_end = std::sregex_iterator();
 
@@ -117,13 +135,11 @@ void LP::Telemetry::parse_frame(const std::string& frame_stream)
             // save the value
             try
             {
-                const double val = std::stod(value, nullptr);
-
-                data[ch_id].values.push_back(val);
+                push_value(data[ch_id], std::stod(value, nullptr));
             }
             catch ([[maybe_unused]] const std::invalid_argument& e)
             {
-                data[ch_id].values.push_back(NAN);
+                push_value(data[ch_id], NAN);
             }
 
             ch_id++;
@@ -132,10 +148,78 @@ void LP::Telemetry::parse_frame(const std::string& frame_stream)
         // set the time point only if something has been read
         if (ch_id > 1)
         {
-            times_unix.push_back(get_unix_time());
-            times_elapsed.push_back(get_elapsed_time());
+            times_unix.push_back(times.has_value() ? times->first : get_unix_time());
+            times_elapsed.push_back(times.has_value() ? times->second : get_elapsed_time());
+        }
+    }
+}
+
+void LP::Telemetry::push_frame(const std::vector<double>& frame, const double unix_time, const double elapsed_time)
+{
+    if (frame.empty())
+        return;
+
+    for (size_t i = 0; i < frame.size(); i++)
+    {
+        const int ch_id = static_cast<int>(i) + 1;
+
+        if (!data.contains(ch_id))
+        {
+            data[ch_id].name   = std::format("Data {}", ch_id);
+            data[ch_id].scale  = 1.0f;
+            data[ch_id].offset = 0.0f;
+        }
+
+        push_value(data[ch_id], frame[i]);
+    }
+
+    times_unix.push_back(unix_time);
+    times_elapsed.push_back(elapsed_time);
+}
+
+void LP::Telemetry::push_columns(const double*                                     unix_times,
+                                 const double*                                     elapsed_times,
+                                 const size_t                                      rows,
+                                 const std::vector<std::pair<int, const double*>>& columns)
+{
+    if (rows == 0)
+        return;
+
+    const size_t first = times_unix.size();
+
+    for (const auto& [ch_id, values] : columns)
+    {
+        if (!data.contains(ch_id))
+        {
+            data[ch_id].name   = std::format("Data {}", ch_id);
+            data[ch_id].scale  = 1.0f;
+            data[ch_id].offset = 0.0f;
         }
+
+        Channel& channel = data[ch_id];
+
+        // channels created after the first rows start with a gap
+        while (channel.values.size() < first)
+            push_value(channel, std::nan(""));
+
+        for (size_t i = 0; i < rows; i++)
+            push_value(channel, values[i]);
+    }
+
+    for (auto& channel : data | std::views::values)
+    {
+        while (channel.values.size() < first + rows)
+            push_value(channel, std::nan(""));
     }
+
+    times_unix.insert(times_unix.end(), unix_times, unix_times + rows);
+    times_elapsed.insert(times_elapsed.end(), elapsed_times, elapsed_times + rows);
+}
+
+void LP::Telemetry::push_value(Channel& channel, const double value)
+{
+    channel.values.push_back(value);
+    channel.extents.push(value);
 }
 
 std::string LP::Telemetry::format_special_chars(const char* s)
@@ -164,6 +248,75 @@ double LP::Telemetry::get_start_time() const
     return std::chrono::duration<double>(start_time.time_since_epoch()).count();
 }
 
+void LP::Telemetry::replace_data(std::vector<double>&&              unix_times,
+                                 std::vector<double>&&              elapsed_times,
+                                 std::unordered_map<int, Channel>&& channels)
+{
+    frame_fragments = "";
+
+    times_unix    = std::move(unix_times);
+    times_elapsed = std::move(elapsed_times);
+    data          = std::move(channels);
+}
+
+void LP::Telemetry::index_channel(Channel& channel)
+{
+    channel.extents.build(channel.values);
+
+    // the runs are only rebuilt for a channel drawn as a bitfield
+    const bool keeps_runs = channel.runs_end > 0;
+
+    channel.runs.clear();
+    channel.runs_end = 0;
+
+    if (keeps_runs)
+    {
+        extend_runs(channel);
+    }
+}
+
+void LP::Telemetry::extend_runs(Channel& channel)
+{
+    // the values were cleared or replaced since the last call
+    if (channel.runs_end > channel.values.size())
+    {
+        channel.runs.clear();
+        channel.runs_end = 0;
+    }
+
+    for (size_t i = channel.runs_end; i < channel.values.size(); i++)
+    {
+        const double value = channel.values[i];
+
+        if (channel.runs.empty() ||
+            !(channel.runs.back().value == value || (std::isnan(channel.runs.back().value) && std::isnan(value))))
+        {
+            channel.runs.push_back({i, value});
+        }
+    }
+
+    channel.runs_end = channel.values.size();
+}
+
+void LP::Telemetry::update_runs(std::unordered_map<int, Channel>&            channels,
+                                const std::unordered_map<int, ChannelStyle>& ch_styles)
+{
+    for (auto& [ch_id, channel] : channels)
+    {
+        const auto style = ch_styles.find(ch_id);
+
+        if (style != ch_styles.end() && style->second.bits > 0)
+        {
+            extend_runs(channel);
+        }
+        else if (channel.runs_end > 0)
+        {
+            channel.runs     = {};
+            channel.runs_end = 0;
+        }
+    }
+}
+
 // remove
 void LP::Telemetry::clear_values()
 {
@@ -172,6 +325,9 @@ void LP::Telemetry::clear_values()
     for (auto& val : data | std::views::values)
     {
         val.values.clear();
+        val.extents.clear();
+        val.runs.clear();
+        val.runs_end = 0;
     }
 
     times_unix.clear();
@@ -202,72 +358,235 @@ void LP::Telemetry::dump_data(const std::string&                    path,
                               std::unordered_map<int, ChannelStyle> ch_styles,
                               PlotTimeStyle                         ts) const
 {
-    std::ofstream dump(path);
+    write_csv(path, snapshot(limits, ch_styles, ts));
+}
+
+LP::Snapshot LP::Telemetry::snapshot(const Limits                                 limits,
+                                     const std::unordered_map<int, ChannelStyle>& ch_styles,
+                                     const PlotTimeStyle                          ts) const
+{
+    Snapshot snap;
+    snap.time_style = ts;
+
+    std::lock_guard lock(data_mtx);
 
     const auto& times = (ts == DATETIME) ? times_unix : times_elapsed;
 
-    // check if the file was opened correctly
-    if (!dump.is_open())
+    // get time window
+    const size_t first = std::distance(times.begin(), std::ranges::lower_bound(times, limits.x_min));
+    const size_t last  = std::distance(times.begin(), std::ranges::upper_bound(times, limits.x_max));
+
+    if (first < last)
     {
-        std::cerr << "Error while opening dump file." << std::endl;
-        return;
+        snap.times.assign(times.begin() + first, times.begin() + last);
     }
 
-    // === write labels ===
-    dump << "times";
-
-    std::lock_guard lock(data_mtx);
     for (const auto& [id, channel] : data)
     {
-        if (ch_styles[id].show)
-            dump << ";" << channel.name;
+        if (const auto style = ch_styles.find(id); style == ch_styles.end() || !style->second.show)
+            continue;
+
+        snap.names.push_back(channel.name);
+
+        std::vector<double>& column = snap.columns.emplace_back(snap.times.size(), std::nan(""));
+
+        for (size_t i = first; i < std::min(last, channel.values.size()); i++)
+        {
+            if (double val = channel.values[i] * channel.scale + channel.offset;
+                val >= limits.y_min && val <= limits.y_max)
+            {
+                column[i - first] = val;
+            }
+        }
     }
-    dump << "\n";
 
-    // get time window
-    auto min_x_it = std::ranges::lower_bound(times, limits.x_min);
-    auto max_x_it = std::ranges::upper_bound(times, limits.x_max);
+    return snap;
+}
 
-    // check if found min is within the range
-    if ((min_x_it != times.end()) && (*min_x_it < limits.x_min || *min_x_it > limits.x_max))
+bool LP::Telemetry::write_csv(const std::string&       path,
+                              const Snapshot&          snapshot,
+                              std::atomic<size_t>*     progress,
+                              const std::atomic<bool>* cancel)
+{
+    // `.gz` dumps are compressed on another thread while the next block is formatted
+    const bool    compressed = GzipWriter::is_gzip_path(path);
+    GzipWriter    gzip;
+    std::ofstream dump;
+
+    if (compressed)
+        gzip.open(path);
+    else
+        dump.open(path);
+
+    // check if the file was opened correctly
+    if (!dump.is_open() && !gzip.is_open())
     {
-        min_x_it = times.end();
+        std::cerr << "Error while opening dump file." << std::endl;
+        return false;
     }
 
-    max_x_it = std::prev(max_x_it);
+    const auto write_block = [&](std::string& block)
+    {
+        if (compressed)
+            return gzip.write(block);
+
+        dump.write(block.data(), static_cast<std::streamsize>(block.size()));
+        block.clear();
+
+        return dump.good();
+    };
+
+    std::string header;
+    CsvFormatter::append_header(header, snapshot);
 
-    // write data to file
-    for (auto it = min_x_it; it <= max_x_it; ++it)
+    if (!write_block(header))
     {
-        dump << ((ts == DATETIME) ? format_datetime(*it) : std::format("{:.0f}", *it));
+        std::cerr << "Error while writing dump file." << std::endl;
+        return false;
+    }
 
-        for (const auto& [id, channel] : data)
-        {
-            if (!ch_styles[id].show)
-                continue;
+    // the rows are formatted in blocks of about CSV_WRITE_BLOCK bytes by a thread per core, while this thread writes
+    // the formatted blocks in order; formatters run at most CSV_FORMAT_AHEAD blocks per thread ahead of the writer
+    const size_t row_bytes     = (snapshot.columns.size() + 1) * CSV_FIELD_BYTES;
+    const size_t rows          = snapshot.times.size();
+    const size_t block_rows    = std::max<size_t>(1, CSV_WRITE_BLOCK / row_bytes);
+    const size_t blocks        = (rows + block_rows - 1) / block_rows;
+    const size_t threads_count = std::min<size_t>(blocks, std::max(1u, std::thread::hardware_concurrency()));
+    const size_t window        = std::max<size_t>(1, threads_count * CSV_FORMAT_AHEAD);
+
+    std::vector<std::string> slots(window);
+    std::mutex               mtx;
+    std::condition_variable  cv;
+
+    // guarded by `mtx`
+    std::vector<bool> ready(window, false);
+    size_t            next_block = 0;
+    size_t            done       = 0;
+    bool              stopping   = false;
+
+    const auto format_blocks = [&]()
+    {
+        CsvFormatter formatter;
 
-            size_t      data_i = std::distance(times.begin(), it);
-            std::string val_str;
+        while (true)
+        {
+            size_t block;
 
-            if (data_i < channel.values.size())
             {
+                std::unique_lock lock(mtx);
+                cv.wait(lock, [&]() { return stopping || next_block == blocks || next_block < done + window; });
+
+                if (stopping || next_block == blocks)
+                    return;
 
-                if (double val = channel.values.at(data_i) * channel.scale + channel.offset;
-                    val >= limits.y_min && val <= limits.y_max)
-                {
-                    val_str = std::to_string(val);
+                block = next_block++;
+            }
+
+            // the slot was freed by the writer, no one else touches it until it's ready
+            std::string& out = slots[block % window];
+            out.reserve(CSV_WRITE_BLOCK + 4096);
+
+            for (size_t row = block * block_rows; row < std::min(rows, (block + 1) * block_rows); row++)
+            {
+                formatter.append_row(out, snapshot, row);
+            }
 
-                    std::ranges::replace(val_str, '.', ',');
-                }
+            {
+                std::lock_guard lock(mtx);
+                ready[block % window] = true;
             }
 
-            dump << ";" << val_str;
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < threads_count; t++)
+    {
+        threads.emplace_back(format_blocks);
+    }
+
+    const auto join = [&]()
+    {
+        {
+            std::lock_guard lock(mtx);
+            stopping = true;
+        }
+
+        cv.notify_all();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    bool written = true;
+
+    for (size_t block = 0; block < blocks; block++)
+    {
+        {
+            std::unique_lock lock(mtx);
+            cv.wait(lock, [&]() { return ready[block % window]; });
+
+            ready[block % window] = false;
+        }
+
+        if (!write_block(slots[block % window]))
+        {
+            std::cerr << "Error while writing dump file." << std::endl;
+            written = false;
+            break;
+        }
+
+        // publish the progress and check for cancellation after every block
+        if (progress != nullptr)
+            progress->store(std::min(rows, (block + 1) * block_rows), std::memory_order_relaxed);
+
+        if (cancel != nullptr && cancel->load(std::memory_order_relaxed))
+        {
+            written = false;
+            break;
         }
-        dump << "\n";
+
+        {
+            std::lock_guard lock(mtx);
+            done++;
+        }
+
+        cv.notify_all();
+    }
+
+    join();
+
+    if (!written)
+    {
+        return false;
+    }
+
+    if (progress != nullptr)
+        progress->store(rows, std::memory_order_relaxed);
+
+    if (compressed)
+    {
+        written = gzip.close() && written;
+    }
+    else
+    {
+        dump.close();
+        written = !dump.fail() && written;
     }
+
+    if (!written)
+    {
+        std::cerr << "Error while writing dump file." << std::endl;
+        return false;
+    }
+
     std::cout << "Dump done!!" << std::endl;
 
-    dump.close();
+    return true;
 }
 
 std::string LP::Telemetry::format_datetime(const double unix_timestamp)
@@ -275,7 +594,13 @@ std::string LP::Telemetry::format_datetime(const double unix_timestamp)
     // get time from system clock
     const auto time = static_cast<time_t>(unix_timestamp);
 
-    const std::tm tm = *std::localtime(&time);
+    // reentrant, exports format datetimes on several threads
+    std::tm tm = {};
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
 
     // format the string
     std::ostringstream oss;
@@ -1,3 +1,5 @@
+#include <LP/byteLog.h>
+#include <LP/recorder.h>
 #include <LP/serial.h>
 #include <LP/toolbar.h>
 #include <algorithm>
@@ -63,7 +65,13 @@ LP::app_state_t LP::ToolBar::get_new_app_state(const app_state_t& curr_app_state
     return state;
 }
 
-void LP::ToolBar::render(app_state_t app_state, bool no_telemetry, const std::vector<std::string>& serial_ports)
+void LP::ToolBar::render(app_state_t                     app_state,
+                         bool                            no_telemetry,
+                         bool                            capturing,
+                         bool                            recording,
+                         bool                            raw_recording,
+                         std::optional<JobProgress>      job,
+                         const std::vector<std::string>& serial_ports)
 {
     // get prev selected port and baud rate
     const char* selected_port = combobox_port_index.has_value() && combobox_port_index <= serial_ports.size()
@@ -149,7 +157,10 @@ void LP::ToolBar::render(app_state_t app_state, bool no_telemetry, const std::ve
 
         ImGui::TableNextColumn();
 
-        if (no_telemetry)
+        // one save or load at a time
+        const bool save_disabled = no_telemetry || job.has_value();
+
+        if (save_disabled)
         {
             ImGui::BeginDisabled();
         }
@@ -158,7 +169,7 @@ void LP::ToolBar::render(app_state_t app_state, bool no_telemetry, const std::ve
         save_button = ImGui::Button(ICON_LC_SAVE, buttons_size);
         ImGui::PopStyleVar();
 
-        if (no_telemetry)
+        if (save_disabled)
         {
             ImGui::EndDisabled();
         }
@@ -166,10 +177,187 @@ void LP::ToolBar::render(app_state_t app_state, bool no_telemetry, const std::ve
         ImGui::EndTable();
     }
 
-    // stop reading if the Save button has been pressed
-    if (app_state == READING && save_button)
+    // ====== Plot capture ======
+    if (capturing)
+    {
+        capture_frames_button = ImGui::Button("Stop recording", ImVec2(ImGui::GetContentRegionAvail().x, 0));
+        capture_video_button  = false;
+    }
+    else
+    {
+        const float half_width = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x) * 0.5f;
+
+        capture_frames_button = ImGui::Button("Record PNG", ImVec2(half_width, 0));
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Save every frame of the plot as a numbered PNG image");
+        }
+
+        ImGui::SameLine();
+
+        capture_video_button = ImGui::Button("Record video", ImVec2(half_width, 0));
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Save every frame of the plot to a raw RGBA video stream, e.g. for ffmpeg's rawvideo");
+        }
+    }
+
+    // ====== Record to disk ======
+    if (ImGui::BeginTable("##record_layout", 2))
+    {
+        ImGui::TableSetupColumn("Left", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+        ImGui::TableSetupColumn("Right", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        bool record_checkbox = recording;
+        record_button        = ImGui::Checkbox("Record to disk", &record_checkbox);
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Append every received frame to a CSV file while reading");
+        }
+
+        ImGui::TableNextColumn();
+
+        // fsync cadence of the recorded file
+        sync_changed = false;
+
+        ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 5);
+        if (ImGui::BeginCombo("##sync", LP::sync_options[combobox_sync_index].label))
+        {
+            for (size_t i = 0; i < LP::sync_options.size(); i++)
+            {
+                if (const bool selected = combobox_sync_index == i;
+                    ImGui::Selectable(LP::sync_options[i].label, selected))
+                {
+                    combobox_sync_index = i;
+                    sync_changed        = true;
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("How often the recorded file is flushed to the disk");
+        }
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        // rotation of the next recordings
+        if (recording)
+        {
+            ImGui::BeginDisabled();
+        }
+
+        ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+        if (ImGui::BeginCombo("##rotation", LP::rotation_options[combobox_rotation_index].label))
+        {
+            for (size_t i = 0; i < LP::rotation_options.size(); i++)
+            {
+                if (const bool selected = combobox_rotation_index == i;
+                    ImGui::Selectable(LP::rotation_options[i].label, selected))
+                {
+                    combobox_rotation_index = i;
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        {
+            ImGui::SetTooltip("Split long recordings into numbered files, listed by a .lpidx index");
+        }
+
+        ImGui::TableNextColumn();
+
+        ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 5);
+        if (ImGui::InputInt("##keep_files", &keep_files))
+        {
+            keep_files = std::max(keep_files, 1);
+        }
+
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        {
+            ImGui::SetTooltip("Files kept by a split recording, the oldest ones are deleted");
+        }
+
+        if (recording)
+        {
+            ImGui::EndDisabled();
+        }
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        bool raw_record_checkbox = raw_recording;
+        raw_record_button        = ImGui::Checkbox("Record raw bytes", &raw_record_checkbox);
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Save the bytes read from the port, to replay them later with Open file");
+        }
+
+        ImGui::TableNextColumn();
+
+        // speed of the replays started with Open file
+        ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 5);
+        if (ImGui::BeginCombo("##replay", LP::replay_speeds[combobox_replay_index].label))
+        {
+            for (size_t i = 0; i < LP::replay_speeds.size(); i++)
+            {
+                if (const bool selected = combobox_replay_index == i;
+                    ImGui::Selectable(LP::replay_speeds[i].label, selected))
+                {
+                    combobox_replay_index = i;
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("Replay speed of raw byte captures");
+        }
+
+        ImGui::EndTable();
+    }
+
+    // ====== Open file ======
+    if (app_state == READING || job.has_value())
+    {
+        ImGui::BeginDisabled();
+    }
+
+    open_button = ImGui::Button("Open file", ImVec2(ImGui::GetContentRegionAvail().x, 0));
+
+    if (app_state == READING || job.has_value())
+    {
+        ImGui::EndDisabled();
+    }
+
+    // ====== Save/load progress ======
+    if (job.has_value())
+    {
+        const float cancel_width = ImGui::CalcTextSize("Cancel").x + ImGui::GetStyle().FramePadding.x * 2;
+
+        ImGui::ProgressBar(job->fraction,
+                           ImVec2(ImGui::GetContentRegionAvail().x - cancel_width - ImGui::GetStyle().ItemSpacing.x, 0),
+                           job->label);
+        ImGui::SameLine();
+        cancel_job_button = ImGui::Button("Cancel");
+    }
+    else
     {
-        open_close_button = true;
+        cancel_job_button = false;
     }
 
     // =========== ADVANCED SERIAL CONFIG ===========
@@ -1,6 +1,8 @@
 #define GLFW_INCLUDE_NONE
 
 #include <GLFW/glfw3.h>
+#include <LP/capture.h>
+#include <LP/gpuPlot.h>
 #include <LP/icon_data.h>
 #include <LP/serial.h>
 #include <LP/window.h>
@@ -10,6 +12,7 @@
 #include <nfd.h>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "../bindings/imgui_impl_glfw.h"
 #include "../bindings/imgui_impl_opengl3.h"
@@ -106,12 +109,16 @@ void LP::Window::init(int t_width, int t_height, const char* title)
 
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
+
+    // optional, the plot functions fall back to ImPlot when it's not available
+    GpuPlot::init(glsl_version);
 }
 
 bool LP::Window::render_mainloop(const std::function<void()>& content)
 {
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
+    GpuPlot::new_frame();
     glfwGetWindowSize(window, &m_width, &m_height);
     glfwPollEvents();
     ImGui::NewFrame();
@@ -122,6 +129,9 @@ bool LP::Window::render_mainloop(const std::function<void()>& content)
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
+    // read back the frame before it's swapped out of the back buffer
+    Capture::capture();
+
     glfwSwapBuffers(window);
     glClear(GL_COLOR_BUFFER_BIT);
     glfwPollEvents();
@@ -147,6 +157,8 @@ void LP::Window::render_toolbar(const std::function<void()>& content)
 
 void LP::Window::destroy()
 {
+    Capture::destroy();
+    GpuPlot::destroy();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -156,7 +168,39 @@ void LP::Window::destroy()
     glfwTerminate();
 }
 
-std::string LP::Window::render_save_fd(const char* default_name)
+std::string LP::Window::render_save_fd(const char* default_name, const std::vector<FileFilter>& filters)
+{
+    NFD_Init();
+
+    std::string path_str;
+
+    nfdu8char_t* out_path = nullptr;
+
+    std::vector<nfdu8filteritem_t> filter_items;
+
+    for (const auto& [name, spec] : filters)
+    {
+        filter_items.push_back({name, spec});
+    }
+
+    if (const nfdresult_t res =
+            NFD_SaveDialogU8(&out_path,
+                             filter_items.data(),
+                             static_cast<nfdfiltersize_t>(filter_items.size()),
+                             ".",
+                             default_name);
+        res == NFD_OKAY)
+    {
+        path_str = out_path;
+        NFD_FreePath(out_path);
+    }
+
+    NFD_Quit();
+
+    return path_str;
+}
+
+std::string LP::Window::render_open_fd(const std::vector<FileFilter>& filters)
 {
     NFD_Init();
 
@@ -164,9 +208,16 @@ std::string LP::Window::render_save_fd(const char* default_name)
 
     nfdu8char_t* out_path = nullptr;
 
-    constexpr nfdu8filteritem_t filter_item[1] = {{"CSV File", "csv"}};
+    std::vector<nfdu8filteritem_t> filter_items;
+
+    for (const auto& [name, spec] : filters)
+    {
+        filter_items.push_back({name, spec});
+    }
 
-    if (const nfdresult_t res = NFD_SaveDialogU8(&out_path, filter_item, 1, ".", default_name); res == NFD_OKAY)
+    if (const nfdresult_t res =
+            NFD_OpenDialogU8(&out_path, filter_items.data(), static_cast<nfdfiltersize_t>(filter_items.size()), ".");
+        res == NFD_OKAY)
     {
         path_str = out_path;
         NFD_FreePath(out_path);
@@ -1621,6 +1621,119 @@ inline ImPlotDateTimeSpec GetDateTimeFmt(const ImPlotDateTimeSpec* ctx, ImPlotTi
     return fmt;
 }
 
+// Gets the tick cache of a time axis whose level 0 unit is unit0 and whose range starts at t_min, recycling the least
+// recently used one if there's no cache for it yet
+static ImPlotTimeTickCache& GetTimeTickCache(ImPlotTimeUnit unit0, const ImPlotTime& t_min)
+{
+    ImPlotContext&     gp        = *GImPlot;
+    const ImPlotStyle& style     = gp.Style;
+    ImFont*            font      = ImGui::GetFont();
+    const float        font_size = ImGui::GetFontSize();
+    const int          frame     = ImGui::GetFrameCount();
+    // prefer a cache already covering the range
+    ImPlotTimeTickCache* cache = nullptr;
+    ImPlotTimeTickCache* lru   = &gp.TimeTickCaches[0];
+    for (int i = 0; i < IMPLOT_TIME_TICK_CACHES; ++i)
+    {
+        ImPlotTimeTickCache& c = gp.TimeTickCaches[i];
+        if (c.Matches(unit0, style, font, font_size) && (cache == nullptr || c.Covers(t_min)))
+            cache = &c;
+        if (c.LastFrame < lru->LastFrame)
+            lru = &c;
+    }
+    // a cache with another range already used this frame belongs to another axis
+    if (cache != nullptr && !cache->Covers(t_min) && cache->LastFrame == frame)
+        cache = nullptr;
+    if (cache == nullptr)
+    {
+        const ImPlotTimeUnit unit1 = ImClamp(unit0 + 1, 0, ImPlotTimeUnit_COUNT - 1);
+        cache                      = lru;
+        cache->Reset();
+        cache->Unit0          = unit0;
+        cache->UseLocalTime   = style.UseLocalTime;
+        cache->UseISO8601     = style.UseISO8601;
+        cache->Use24HourClock = style.Use24HourClock;
+        cache->Font           = font;
+        cache->FontSize       = font_size;
+        cache->FmtWidth[0]    = GetDateTimeWidth(GetDateTimeFmt(TimeFormatLevel0, unit0));
+        cache->FmtWidth[1]    = GetDateTimeWidth(GetDateTimeFmt(TimeFormatLevel1, unit1));
+        cache->FmtWidth[2]    = GetDateTimeWidth(GetDateTimeFmt(TimeFormatLevel1First, unit1));
+    }
+    cache->LastFrame = frame;
+    return *cache;
+}
+
+// Makes the cached level 1 divisions span exactly from the one containing t_min to the one containing t_max
+static void UpdateTimeTickCache(ImPlotTimeTickCache& cache,
+                                ImPlotTimeUnit       unit0,
+                                ImPlotTimeUnit       unit1,
+                                int                  step,
+                                bool                 minors,
+                                const ImPlotTime&    t_min,
+                                const ImPlotTime&    t_max)
+{
+    if (cache.Step != step || cache.Minors != minors || !cache.Covers(t_min) ||
+        cache.TextBuffer.size() > IMPLOT_TIME_TICK_CACHE_TEXT_MAX)
+    {
+        cache.Ticks.shrink(0);
+        cache.TextBuffer.Buf.shrink(0);
+        cache.Step   = step;
+        cache.Minors = minors;
+        cache.End    = FloorTime(t_min, unit1);
+    }
+    // drop the divisions that scrolled out of the range
+    int first = 0;
+    for (int i = 1; i < cache.Ticks.Size && !(t_min < cache.Ticks[i].Time); ++i)
+    {
+        if (cache.Ticks[i].Major)
+            first = i;
+    }
+    if (first > 0)
+        cache.Ticks.erase(cache.Ticks.Data, cache.Ticks.Data + first);
+    // add the divisions that scrolled in
+    while (cache.End < t_max)
+    {
+        const ImPlotTime t1 = cache.End;
+        const ImPlotTime t2 = AddTime(t1, unit1, 1);
+        cache.Ticks.push_back(ImPlotTimeTick(t1, true));
+        if (minors)
+        {
+            for (ImPlotTime t12 = AddTime(t1, unit0, step); t12 < t2; t12 = AddTime(t12, unit0, step))
+                cache.Ticks.push_back(ImPlotTimeTick(t12, false));
+        }
+        cache.End = t2;
+    }
+}
+
+// Adds a cached time tick to the ticker, formatting its label with fmt only the first time it's shown
+static ImPlotTick& AddTimeTick(ImPlotTicker&             ticker,
+                               ImPlotTimeTickCache&      cache,
+                               ImPlotTimeTick&           time_tick,
+                               int                       fmt_idx,
+                               const ImPlotDateTimeSpec& fmt,
+                               bool                      major,
+                               int                       level,
+                               bool                      show_label)
+{
+    ImPlotTick tick(time_tick.Time.ToDouble(), major, level, show_label);
+    if (show_label)
+    {
+        if (time_tick.TextOffset[fmt_idx] < 0)
+        {
+            char buff[IMPLOT_LABEL_MAX_SIZE];
+            FormatDateTime(time_tick.Time, buff, sizeof(buff), fmt);
+            time_tick.TextOffset[fmt_idx] = cache.TextBuffer.size();
+            time_tick.LabelSize[fmt_idx]  = ImGui::CalcTextSize(buff);
+            cache.TextBuffer.append(buff, buff + strlen(buff) + 1);
+        }
+        const char* label = cache.TextBuffer.Buf.Data + time_tick.TextOffset[fmt_idx];
+        tick.TextOffset   = ticker.TextBuffer.size();
+        tick.LabelSize    = time_tick.LabelSize[fmt_idx];
+        ticker.TextBuffer.append(label, label + strlen(label) + 1);
+    }
+    return ticker.AddTick(tick);
+}
+
 void Locator_Time(ImPlotTicker&      ticker,
                   const ImPlotRange& range,
                   float              pixels,
@@ -1650,34 +1763,38 @@ void Locator_Time(ImPlotTicker&      ticker,
     ftd.UserFormatterData = formatter_data;
     if (unit0 != ImPlotTimeUnit_Yr)
     {
+        ImPlotTimeTickCache& cache = GetTimeTickCache(unit0, t_min);
         // pixels per major (level 1) division
         const float pix_per_major_div = pixels / (float)(range.Size() / TimeUnitSpans[unit1]);
         // nominal pixels taken up by labels
-        const float fmt0_width = GetDateTimeWidth(fmt0);
-        const float fmt1_width = GetDateTimeWidth(fmt1);
-        const float fmtf_width = GetDateTimeWidth(fmtf);
+        const float fmt0_width = cache.FmtWidth[0];
+        const float fmt1_width = cache.FmtWidth[1];
+        const float fmtf_width = cache.FmtWidth[2];
         // the maximum number of minor (level 0) labels that can fit between major (level 1)
         // divisions
         const int minor_per_major = (int)(max_density * pix_per_major_div / fmt0_width);
         // the minor step size (level 0)
         const int step = GetTimeStep(minor_per_major, unit0);
-        // generate ticks
-        ImPlotTime t1 = FloorTime(ImPlotTime::FromDouble(range.Min), unit1);
-        while (t1 < t_max)
+        // generate the ticks that entered the range since the last frame
+        UpdateTimeTickCache(cache, unit0, unit1, step, minor_per_major > 1, t_min, t_max);
+        ImVector<ImPlotTimeTick>& ticks = cache.Ticks;
+        for (int i = 0; i < ticks.Size && ticks[i].Time < t_max;)
         {
-            // get next major
-            const ImPlotTime t2 = AddTime(t1, unit1, 1);
+            // division [i, j) spans from t1 to the next major t2
+            int j = i + 1;
+            while (j < ticks.Size && !ticks[j].Major)
+                ++j;
+            const ImPlotTime t1 = ticks[i].Time;
+            const ImPlotTime t2 = j < ticks.Size ? ticks[j].Time : cache.End;
             // add major tick
             if (t1 >= t_min && t1 <= t_max)
             {
                 // minor level 0 tick
-                ftd.Time = t1;
-                ftd.Spec = fmt0;
-                ticker.AddTick(t1.ToDouble(), true, 0, true, Formatter_Time, &ftd);
+                AddTimeTick(ticker, cache, ticks[i], 0, fmt0, true, 0, true);
                 // major level 1 tick
-                ftd.Time               = t1;
-                ftd.Spec               = last_major_offset < 0 ? fmtf : fmt1;
-                ImPlotTick& tick_maj   = ticker.AddTick(t1.ToDouble(), true, 1, true, Formatter_Time, &ftd);
+                const int   fmt_idx  = last_major_offset < 0 ? 2 : 1;
+                ImPlotTick& tick_maj =
+                    AddTimeTick(ticker, cache, ticks[i], fmt_idx, fmt_idx == 2 ? fmtf : fmt1, true, 1, true);
                 const char* this_major = ticker.GetText(tick_maj);
                 if (last_major_offset >= 0 && TimeLabelSame(ticker.TextBuffer.Buf.Data + last_major_offset, this_major))
                     tick_maj.ShowLabel = false;
@@ -1686,28 +1803,23 @@ void Locator_Time(ImPlotTicker&      ticker,
             // add minor ticks up until next major
             if (minor_per_major > 1 && (t_min <= t2 && t1 <= t_max))
             {
-                ImPlotTime t12 = AddTime(t1, unit0, step);
-                while (t12 < t2)
+                for (int k = i + 1; k < j; ++k)
                 {
-                    float px_to_t2 = (float)((t2 - t12).ToDouble() / range.Size()) * pixels;
+                    const ImPlotTime t12      = ticks[k].Time;
+                    float            px_to_t2 = (float)((t2 - t12).ToDouble() / range.Size()) * pixels;
                     if (t12 >= t_min && t12 <= t_max)
                     {
-                        ftd.Time = t12;
-                        ftd.Spec = fmt0;
-                        ticker.AddTick(t12.ToDouble(), false, 0, px_to_t2 >= fmt0_width, Formatter_Time, &ftd);
+                        AddTimeTick(ticker, cache, ticks[k], 0, fmt0, false, 0, px_to_t2 >= fmt0_width);
                         if (last_major_offset < 0 && px_to_t2 >= fmt0_width &&
                             px_to_t2 >= (fmt1_width + fmtf_width) / 2)
                         {
-                            ftd.Time             = t12;
-                            ftd.Spec             = fmtf;
-                            ImPlotTick& tick_maj = ticker.AddTick(t12.ToDouble(), true, 1, true, Formatter_Time, &ftd);
+                            ImPlotTick& tick_maj = AddTimeTick(ticker, cache, ticks[k], 2, fmtf, true, 1, true);
                             last_major_offset    = tick_maj.TextOffset;
                         }
                     }
-                    t12 = AddTime(t12, unit0, step);
                 }
             }
-            t1 = t2;
+            i = j;
         }
     }
     else
@@ -60,6 +60,10 @@
 #define IMPLOT_LABEL_FORMAT "%g"
 // Max character size for tick labels
 #define IMPLOT_LABEL_MAX_SIZE 32
+// Number of time axis tick caches kept by the context (one per time axis with a distinct range visible at once)
+#define IMPLOT_TIME_TICK_CACHES 4
+// Size of the formatted labels of a time tick cache over which it's rebuilt
+#define IMPLOT_TIME_TICK_CACHE_TEXT_MAX 16384
 
 //-----------------------------------------------------------------------------
 // [SECTION] Macros
@@ -835,6 +839,74 @@ struct ImPlotTicker
     }
 };
 
+// Time tick kept across frames by Locator_Time, with its labels formatted the first time they are shown
+struct ImPlotTimeTick
+{
+    ImPlotTime Time;
+    bool       Major;         // start of a level 1 division
+    int        TextOffset[3]; // level 0, level 1 and first level 1 labels offsets in the cache text buffer, or -1
+    ImVec2     LabelSize[3];
+
+    ImPlotTimeTick(const ImPlotTime& time, bool major)
+    {
+        Time          = time;
+        Major         = major;
+        TextOffset[0] = TextOffset[1] = TextOffset[2] = -1;
+    }
+};
+
+// Time ticks generated for a time unit and step, so that a scrolling time axis only has to generate and format the
+// ticks entering its range instead of every tick each frame
+struct ImPlotTimeTickCache
+{
+    // key
+    ImPlotTimeUnit Unit0;
+    bool           UseLocalTime;
+    bool           UseISO8601;
+    bool           Use24HourClock;
+    ImFont*        Font;
+    float          FontSize;
+    int            Step;
+    bool           Minors;
+
+    float                    FmtWidth[3]; // nominal widths of the level 0, level 1 and first level 1 labels
+    ImVector<ImPlotTimeTick> Ticks;       // contiguous level 1 divisions, each major followed by its minors
+    ImPlotTime               End;         // start of the division following the last cached one
+    ImGuiTextBuffer          TextBuffer;
+    int                      LastFrame;
+
+    ImPlotTimeTickCache()
+    {
+        Unit0          = -1;
+        UseLocalTime   = false;
+        UseISO8601     = false;
+        Use24HourClock = false;
+        Font           = nullptr;
+        FontSize       = 0;
+        Step           = 0;
+        Minors         = false;
+        LastFrame      = -1;
+        FmtWidth[0] = FmtWidth[1] = FmtWidth[2] = 0;
+    }
+
+    bool Matches(ImPlotTimeUnit unit0, const ImPlotStyle& style, ImFont* font, float font_size) const
+    {
+        return Unit0 == unit0 && UseLocalTime == style.UseLocalTime && UseISO8601 == style.UseISO8601 &&
+               Use24HourClock == style.Use24HourClock && Font == font && FontSize == font_size;
+    }
+
+    bool Covers(const ImPlotTime& t) const
+    {
+        return Ticks.Size > 0 && !(t < Ticks[0].Time) && t < End;
+    }
+
+    void Reset()
+    {
+        Ticks.shrink(0);
+        TextBuffer.Buf.shrink(0);
+    }
+};
+
 // Axis state information that must persist after EndPlot
 struct ImPlotAxis
 {
@@ -1677,7 +1749,8 @@ struct ImPlotContext
     ImVector<ImPlotColormap> ColormapModifiers;
 
     // Time
-    tm Tm;
+    tm                  Tm;
+    ImPlotTimeTickCache TimeTickCaches[IMPLOT_TIME_TICK_CACHES];
 
     // Temp data for general use
     ImVector<double> TempDouble1, TempDouble2;
@@ -29,6 +29,14 @@
 #ifndef IMGUI_DISABLE
 #include "implot_internal.h"
 
+#ifndef IMPLOT_NO_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Macros and Defines
 //-----------------------------------------------------------------------------
@@ -62,6 +70,17 @@ static IMPLOT_INLINE float ImInvSqrt(float x)
 {
     return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
 }
+// SIMD kernels used by the batch data-to-pixel transforms. AVX2 is used directly when the compiler
+// targets it, otherwise GCC/Clang builds dispatch to it at runtime.
+#if defined __SSE2__ || defined __x86_64__ || defined _M_X64
+#define IMPLOT_SIMD_SSE2
+#endif
+#if defined __AVX2__
+#define IMPLOT_SIMD_AVX2
+#elif (defined __GNUC__ || defined __clang__) && (defined __x86_64__ || defined __i386__)
+#define IMPLOT_SIMD_AVX2
+#define IMPLOT_SIMD_AVX2_DISPATCH
+#endif
 #else
 static IMPLOT_INLINE float ImInvSqrt(float x)
 {
@@ -87,6 +106,17 @@ static IMPLOT_INLINE float ImInvSqrt(float x)
 #define ImDrawFlags_RoundCornersAll ImDrawCornerFlags_All
 #endif
 
+// Minimum number of primitives in a single batch before RenderPrimitivesEx splits vertex generation
+// across the worker pool. Define IMPLOT_NO_THREADS to always generate vertices on the calling thread.
+#ifndef IMPLOT_PARALLEL_MIN_PRIMS
+#define IMPLOT_PARALLEL_MIN_PRIMS 8192
+#endif
+
+// Number of points renderers transform to pixel space at once (see TransformCache).
+#ifndef IMPLOT_TRANSFORM_BLOCK
+#define IMPLOT_TRANSFORM_BLOCK 256
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Template instantiation utility
 //-----------------------------------------------------------------------------
@@ -748,6 +778,30 @@ template <typename T> struct GetterError
     const int      Stride;
 };
 
+/// Tells whether a getter can be evaluated concurrently from several threads. User callbacks
+/// (GetterFuncPtr) give no such guarantee, so anything built on top of them stays serial.
+template <typename _Getter> struct GetterTraits
+{
+    static const bool ThreadSafe = true;
+};
+
+template <> struct GetterTraits<GetterFuncPtr>
+{
+    static const bool ThreadSafe = false;
+};
+
+template <typename _Getter> struct GetterTraits<GetterOverrideX<_Getter>> : GetterTraits<_Getter>
+{
+};
+
+template <typename _Getter> struct GetterTraits<GetterOverrideY<_Getter>> : GetterTraits<_Getter>
+{
+};
+
+template <typename _Getter> struct GetterTraits<GetterLoop<_Getter>> : GetterTraits<_Getter>
+{
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Fitters
 //-----------------------------------------------------------------------------
@@ -981,6 +1035,139 @@ struct Transformer2
     Transformer1 Ty;
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] Batch Transformers
+//-----------------------------------------------------------------------------
+
+// Linear (and time) scales have no forward transform, so converting a point to pixels is a single
+// multiply-add per axis. These kernels do it for contiguous blocks of doubles and write interleaved
+// x/y floats straight into an ImVec2 array.
+
+static void TransformLinearScalar(const Transformer2& tf, const double* xs, const double* ys, int count, ImVec2* out)
+{
+    const Transformer1& tx = tf.Tx;
+    const Transformer1& ty = tf.Ty;
+    for (int i = 0; i < count; ++i)
+    {
+        out[i].x = (float)(tx.PixMin + tx.M * (xs[i] - tx.PltMin));
+        out[i].y = (float)(ty.PixMin + ty.M * (ys[i] - ty.PltMin));
+    }
+}
+
+#ifdef IMPLOT_SIMD_SSE2
+static void TransformLinearSSE2(const Transformer2& tf, const double* xs, const double* ys, int count, ImVec2* out)
+{
+    const __m128d x_pix = _mm_set1_pd(tf.Tx.PixMin);
+    const __m128d x_m   = _mm_set1_pd(tf.Tx.M);
+    const __m128d x_plt = _mm_set1_pd(tf.Tx.PltMin);
+    const __m128d y_pix = _mm_set1_pd(tf.Ty.PixMin);
+    const __m128d y_m   = _mm_set1_pd(tf.Ty.M);
+    const __m128d y_plt = _mm_set1_pd(tf.Ty.PltMin);
+    int           i     = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d x = _mm_add_pd(x_pix, _mm_mul_pd(x_m, _mm_sub_pd(_mm_loadu_pd(xs + i), x_plt)));
+        const __m128d y = _mm_add_pd(y_pix, _mm_mul_pd(y_m, _mm_sub_pd(_mm_loadu_pd(ys + i), y_plt)));
+        // [x0 x1 - -], [y0 y1 - -] -> [x0 y0 x1 y1]
+        _mm_storeu_ps(&out[i].x, _mm_unpacklo_ps(_mm_cvtpd_ps(x), _mm_cvtpd_ps(y)));
+    }
+    TransformLinearScalar(tf, xs + i, ys + i, count - i, out + i);
+}
+#endif
+
+#ifdef IMPLOT_SIMD_AVX2
+#ifdef IMPLOT_SIMD_AVX2_DISPATCH
+__attribute__((target("avx2")))
+#endif
+static void TransformLinearAVX2(const Transformer2& tf, const double* xs, const double* ys, int count, ImVec2* out)
+{
+    const __m256d x_pix = _mm256_set1_pd(tf.Tx.PixMin);
+    const __m256d x_m   = _mm256_set1_pd(tf.Tx.M);
+    const __m256d x_plt = _mm256_set1_pd(tf.Tx.PltMin);
+    const __m256d y_pix = _mm256_set1_pd(tf.Ty.PixMin);
+    const __m256d y_m   = _mm256_set1_pd(tf.Ty.M);
+    const __m256d y_plt = _mm256_set1_pd(tf.Ty.PltMin);
+    int           i     = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d x  = _mm256_add_pd(x_pix, _mm256_mul_pd(x_m, _mm256_sub_pd(_mm256_loadu_pd(xs + i), x_plt)));
+        const __m256d y  = _mm256_add_pd(y_pix, _mm256_mul_pd(y_m, _mm256_sub_pd(_mm256_loadu_pd(ys + i), y_plt)));
+        const __m128  xf = _mm256_cvtpd_ps(x);
+        const __m128  yf = _mm256_cvtpd_ps(y);
+        _mm_storeu_ps(&out[i].x, _mm_unpacklo_ps(xf, yf));
+        _mm_storeu_ps(&out[i + 2].x, _mm_unpackhi_ps(xf, yf));
+    }
+    TransformLinearScalar(tf, xs + i, ys + i, count - i, out + i);
+}
+#endif
+
+static void TransformLinear(const Transformer2& tf, const double* xs, const double* ys, int count, ImVec2* out)
+{
+#if defined(IMPLOT_SIMD_AVX2_DISPATCH)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2)
+        return TransformLinearAVX2(tf, xs, ys, count, out);
+#elif defined(IMPLOT_SIMD_AVX2)
+    return TransformLinearAVX2(tf, xs, ys, count, out);
+#endif
+#ifdef IMPLOT_SIMD_SSE2
+    TransformLinearSSE2(tf, xs, ys, count, out);
+#else
+    TransformLinearScalar(tf, xs, ys, count, out);
+#endif
+}
+
+/// Transforms points [first, first + count) of a getter to pixel space.
+template <typename _Getter>
+IMPLOT_INLINE void TransformBlock(const Transformer2& tf, const _Getter& getter, int first, int count, ImVec2* out)
+{
+    for (int i = 0; i < count; ++i)
+        out[i] = tf(getter(first + i));
+}
+
+/// Contiguous double arrays (the common PlotLine/PlotScatter case) on axes without a forward
+/// transform take the SIMD path; log/symlog/custom scales and strided data stay per point.
+IMPLOT_INLINE void TransformBlock(const Transformer2&                                     tf,
+                                  const GetterXY<IndexerIdx<double>, IndexerIdx<double>>& getter,
+                                  int                                                     first,
+                                  int                                                     count,
+                                  ImVec2*                                                 out)
+{
+    const IndexerIdx<double>& ix = getter.IndxerX;
+    const IndexerIdx<double>& iy = getter.IndxerY;
+    if (tf.Tx.TransformFwd == nullptr && tf.Ty.TransformFwd == nullptr && ix.Offset == 0 && iy.Offset == 0 &&
+        ix.Stride == sizeof(double) && iy.Stride == sizeof(double))
+    {
+        TransformLinear(tf, ix.Data + first, iy.Data + first, count, out);
+        return;
+    }
+    for (int i = 0; i < count; ++i)
+        out[i] = tf(getter(first + i));
+}
+
+/// Caches pixel-space points of a getter so that renderers walking the data in order transform it
+/// in blocks of IMPLOT_TRANSFORM_BLOCK instead of one point at a time.
+template <typename _Getter> struct TransformCache
+{
+    TransformCache(const _Getter& getter) : Getter(getter), First(0), Size(0)
+    {
+    }
+    IMPLOT_INLINE ImVec2 operator()(const Transformer2& tf, int idx) const
+    {
+        if ((unsigned int)(idx - First) >= (unsigned int)Size)
+        {
+            First = idx;
+            Size  = ImMin(IMPLOT_TRANSFORM_BLOCK, Getter.Count - idx);
+            TransformBlock(tf, Getter, First, Size, Points);
+        }
+        return Points[idx - First];
+    }
+    const _Getter& Getter;
+    mutable int    First;
+    mutable int    Size;
+    mutable ImVec2 Points[IMPLOT_TRANSFORM_BLOCK];
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Renderers
 //-----------------------------------------------------------------------------
@@ -991,6 +1178,12 @@ struct RendererBase
         : Prims(prims), IdxConsumed(idx_consumed), VtxConsumed(vtx_consumed)
     {
     }
+    // Renderers that set Parallel can be copied and rendered from an arbitrary primitive after a
+    // call to Seek(), and always consume exactly IdxConsumed/VtxConsumed per rendered primitive.
+    static const bool Parallel = false;
+    void              Seek(int) const
+    {
+    }
     const int    Prims;
     Transformer2 Transformer;
     const int    IdxConsumed;
@@ -999,8 +1192,10 @@ struct RendererBase
 
 template <class _Getter> struct RendererLineStrip : RendererBase
 {
+    static const bool Parallel = GetterTraits<_Getter>::ThreadSafe;
     RendererLineStrip(const _Getter& getter, ImU32 col, float weight)
-        : RendererBase(getter.Count - 1, 6, 4), Getter(getter), Col(col), HalfWeight(ImMax(1.0f, weight) * 0.5f)
+        : RendererBase(getter.Count - 1, 6, 4), Getter(getter), Points(getter), Col(col),
+          HalfWeight(ImMax(1.0f, weight) * 0.5f)
     {
         P1 = this->Transformer(Getter(0));
     }
@@ -1008,9 +1203,13 @@ template <class _Getter> struct RendererLineStrip : RendererBase
     {
         GetLineRenderProps(draw_list, HalfWeight, UV0, UV1);
     }
+    void Seek(int prim) const
+    {
+        P1 = this->Transformer(Getter(prim));
+    }
     IMPLOT_INLINE bool Render(ImDrawList& draw_list, const ImRect& cull_rect, int prim) const
     {
-        ImVec2 P2 = this->Transformer(Getter(prim + 1));
+        ImVec2 P2 = Points(this->Transformer, prim + 1);
         if (!cull_rect.Overlaps(ImRect(ImMin(P1, P2), ImMax(P1, P2))))
         {
             P1 = P2;
@@ -1020,18 +1219,21 @@ template <class _Getter> struct RendererLineStrip : RendererBase
         P1 = P2;
         return true;
     }
-    const _Getter& Getter;
-    const ImU32    Col;
-    mutable float  HalfWeight;
-    mutable ImVec2 P1;
-    mutable ImVec2 UV0;
-    mutable ImVec2 UV1;
+    const _Getter&          Getter;
+    TransformCache<_Getter> Points;
+    const ImU32             Col;
+    mutable float           HalfWeight;
+    mutable ImVec2          P1;
+    mutable ImVec2          UV0;
+    mutable ImVec2          UV1;
 };
 
 template <class _Getter> struct RendererLineStripSkip : RendererBase
 {
+    static const bool Parallel = GetterTraits<_Getter>::ThreadSafe;
     RendererLineStripSkip(const _Getter& getter, ImU32 col, float weight)
-        : RendererBase(getter.Count - 1, 6, 4), Getter(getter), Col(col), HalfWeight(ImMax(1.0f, weight) * 0.5f)
+        : RendererBase(getter.Count - 1, 6, 4), Getter(getter), Points(getter), Col(col),
+          HalfWeight(ImMax(1.0f, weight) * 0.5f)
     {
         P1 = this->Transformer(Getter(0));
     }
@@ -1039,9 +1241,20 @@ template <class _Getter> struct RendererLineStripSkip : RendererBase
     {
         GetLineRenderProps(draw_list, HalfWeight, UV0, UV1);
     }
+    void Seek(int prim) const
+    {
+        // P1 is the last valid point seen before prim, or the first point if there is none
+        for (int i = prim; i > 0; --i)
+        {
+            P1 = this->Transformer(Getter(i));
+            if (!ImNan(P1.x) && !ImNan(P1.y))
+                return;
+        }
+        P1 = this->Transformer(Getter(0));
+    }
     IMPLOT_INLINE bool Render(ImDrawList& draw_list, const ImRect& cull_rect, int prim) const
     {
-        ImVec2 P2 = this->Transformer(Getter(prim + 1));
+        ImVec2 P2 = Points(this->Transformer, prim + 1);
         if (!cull_rect.Overlaps(ImRect(ImMin(P1, P2), ImMax(P1, P2))))
         {
             if (!ImNan(P2.x) && !ImNan(P2.y))
@@ -1053,18 +1266,21 @@ template <class _Getter> struct RendererLineStripSkip : RendererBase
             P1 = P2;
         return true;
     }
-    const _Getter& Getter;
-    const ImU32    Col;
-    mutable float  HalfWeight;
-    mutable ImVec2 P1;
-    mutable ImVec2 UV0;
-    mutable ImVec2 UV1;
+    const _Getter&          Getter;
+    TransformCache<_Getter> Points;
+    const ImU32             Col;
+    mutable float           HalfWeight;
+    mutable ImVec2          P1;
+    mutable ImVec2          UV0;
+    mutable ImVec2          UV1;
 };
 
 template <class _Getter> struct RendererLineSegments1 : RendererBase
 {
+    static const bool Parallel = GetterTraits<_Getter>::ThreadSafe;
     RendererLineSegments1(const _Getter& getter, ImU32 col, float weight)
-        : RendererBase(getter.Count / 2, 6, 4), Getter(getter), Col(col), HalfWeight(ImMax(1.0f, weight) * 0.5f)
+        : RendererBase(getter.Count / 2, 6, 4), Getter(getter), Points(getter), Col(col),
+          HalfWeight(ImMax(1.0f, weight) * 0.5f)
     {
     }
     void Init(ImDrawList& draw_list) const
@@ -1073,18 +1289,19 @@ template <class _Getter> struct RendererLineSegments1 : RendererBase
     }
     IMPLOT_INLINE bool Render(ImDrawList& draw_list, const ImRect& cull_rect, int prim) const
     {
-        ImVec2 P1 = this->Transformer(Getter(prim * 2 + 0));
-        ImVec2 P2 = this->Transformer(Getter(prim * 2 + 1));
+        ImVec2 P1 = Points(this->Transformer, prim * 2 + 0);
+        ImVec2 P2 = Points(this->Transformer, prim * 2 + 1);
         if (!cull_rect.Overlaps(ImRect(ImMin(P1, P2), ImMax(P1, P2))))
             return false;
         PrimLine(draw_list, P1, P2, HalfWeight, Col, UV0, UV1);
         return true;
     }
-    const _Getter& Getter;
-    const ImU32    Col;
-    mutable float  HalfWeight;
-    mutable ImVec2 UV0;
-    mutable ImVec2 UV1;
+    const _Getter&          Getter;
+    TransformCache<_Getter> Points;
+    const ImU32             Col;
+    mutable float           HalfWeight;
+    mutable ImVec2          UV0;
+    mutable ImVec2          UV1;
 };
 
 template <class _Getter1, class _Getter2> struct RendererLineSegments2 : RendererBase
@@ -1496,6 +1713,229 @@ template <typename _Getter> struct RendererRectC : RendererBase
 // [SECTION] RenderPrimitives
 //-----------------------------------------------------------------------------
 
+#ifndef IMPLOT_NO_THREADS
+
+/// Small fixed-size pool used to split vertex generation of large batches. The calling thread
+/// always takes part in the work, so a pool of size 1 has no worker threads at all.
+class ImPlotWorkerPool
+{
+  public:
+    typedef void (*JobFunc)(void* ctx, int job);
+
+    ImPlotWorkerPool()
+        : Func(nullptr), Ctx(nullptr), Jobs(0), Next(0), Pending(0), Active(0), Generation(0), Stop(false)
+    {
+        const unsigned int hw = std::thread::hardware_concurrency();
+        for (unsigned int i = 1; i < hw; ++i)
+            Threads.emplace_back(&ImPlotWorkerPool::Loop, this);
+    }
+
+    ~ImPlotWorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Stop = true;
+        }
+        WakeCv.notify_all();
+        for (std::thread& t : Threads)
+            t.join();
+    }
+
+    int Size() const
+    {
+        return (int)Threads.size() + 1;
+    }
+
+    /// Runs func(ctx, i) for every i in [0, jobs) and returns once all of them completed.
+    void Run(int jobs, JobFunc func, void* ctx)
+    {
+        {
+            // a worker that woke up too late for the previous batch may still be leaving it: wait for it, so
+            // that it can't take a job of this batch with the previous function
+            std::unique_lock<std::mutex> lock(Mutex);
+            DoneCv.wait(lock, [this] { return Active == 0; });
+            Func    = func;
+            Ctx     = ctx;
+            Jobs    = jobs;
+            Next    = 0;
+            Pending = jobs;
+            ++Generation;
+        }
+        WakeCv.notify_all();
+        Work(func, ctx, jobs);
+        std::unique_lock<std::mutex> lock(Mutex);
+        DoneCv.wait(lock, [this] { return Pending == 0 && Active == 0; });
+    }
+
+  private:
+    /// Takes jobs until none is left. The batch is passed by value, the fields are only read under Mutex.
+    void Work(JobFunc func, void* ctx, int jobs)
+    {
+        for (int job = Next.fetch_add(1); job < jobs; job = Next.fetch_add(1))
+        {
+            func(ctx, job);
+            if (Pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                DoneCv.notify_all();
+            }
+        }
+    }
+
+    void Loop()
+    {
+        unsigned int seen = 0;
+        for (;;)
+        {
+            JobFunc func;
+            void*   ctx;
+            int     jobs;
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                WakeCv.wait(lock, [&] { return Stop || Generation != seen; });
+                if (Stop)
+                    return;
+                seen = Generation;
+                func = Func;
+                ctx  = Ctx;
+                jobs = Jobs;
+                ++Active;
+            }
+            Work(func, ctx, jobs);
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                --Active;
+            }
+            DoneCv.notify_all();
+        }
+    }
+
+    std::vector<std::thread> Threads;
+    std::mutex               Mutex;
+    std::condition_variable  WakeCv;
+    std::condition_variable  DoneCv;
+    JobFunc                  Func;
+    void*                    Ctx;
+    int                      Jobs;
+    std::atomic<int>         Next;
+    std::atomic<int>         Pending;
+    int                      Active;
+    unsigned int             Generation;
+    bool                     Stop;
+};
+
+static ImPlotWorkerPool& GetWorkerPool()
+{
+    static ImPlotWorkerPool pool;
+    return pool;
+}
+
+/// One slice of a parallel batch: a contiguous range of primitives and the part of the reserved
+/// vertex/index buffers it is allowed to write to.
+struct RenderSlice
+{
+    unsigned int PrimBegin;
+    unsigned int PrimEnd;
+    ImDrawVert*  VtxBegin;
+    ImDrawIdx*   IdxBegin;
+    unsigned int VtxCurrentIdx;
+    ImDrawVert*  VtxEnd;
+    ImDrawIdx*   IdxEnd;
+};
+
+template <class _Renderer> struct RenderSliceJob
+{
+    const _Renderer* Renderer;
+    const ImRect*    CullRect;
+    RenderSlice*     Slices;
+
+    static void Run(void* ctx, int job)
+    {
+        RenderSliceJob& self  = *(RenderSliceJob*)ctx;
+        RenderSlice&    slice = self.Slices[job];
+        // each slice renders through its own copy of the renderer (which carries per-primitive state)
+        // and a detached draw list whose write cursors point into the slice
+        _Renderer  renderer(*self.Renderer);
+        ImDrawList local(nullptr);
+        local._VtxWritePtr   = slice.VtxBegin;
+        local._IdxWritePtr   = slice.IdxBegin;
+        local._VtxCurrentIdx = slice.VtxCurrentIdx;
+        renderer.Seek((int)slice.PrimBegin);
+        for (unsigned int prim = slice.PrimBegin; prim != slice.PrimEnd; ++prim)
+            renderer.Render(local, *self.CullRect, (int)prim);
+        slice.VtxEnd = local._VtxWritePtr;
+        slice.IdxEnd = local._IdxWritePtr;
+    }
+};
+
+static ImVector<RenderSlice>& GetWorkerSlices()
+{
+    static ImVector<RenderSlice> slices;
+    return slices;
+}
+
+/// Renders `cnt` primitives starting at `first` into a reservation of exactly `cnt` primitives that
+/// starts at the draw list's current write cursors. The reservation is split into one slice per
+/// worker, the slices are rendered concurrently and then compacted in order, so the result is
+/// identical to the serial loop. Returns the number of culled primitives, which the caller
+/// unreserves.
+template <class _Renderer>
+unsigned int RenderPrimitivesParallel(
+    const _Renderer& renderer, ImDrawList& draw_list, const ImRect& cull_rect, unsigned int first, unsigned int cnt)
+{
+    ImPlotWorkerPool& pool   = GetWorkerPool();
+    const int         slices = ImMin(pool.Size(), (int)(cnt / (IMPLOT_PARALLEL_MIN_PRIMS / 4)));
+
+    ImVector<RenderSlice>& jobs = GetWorkerSlices();
+    jobs.resize(slices);
+    const unsigned int per_slice = cnt / slices;
+    for (int i = 0; i < slices; ++i)
+    {
+        const unsigned int begin = i * per_slice;
+        jobs[i].PrimBegin        = first + begin;
+        jobs[i].PrimEnd          = (i == slices - 1) ? first + cnt : first + begin + per_slice;
+        jobs[i].VtxBegin         = draw_list._VtxWritePtr + begin * renderer.VtxConsumed;
+        jobs[i].IdxBegin         = draw_list._IdxWritePtr + begin * renderer.IdxConsumed;
+        jobs[i].VtxCurrentIdx    = draw_list._VtxCurrentIdx + begin * renderer.VtxConsumed;
+    }
+
+    RenderSliceJob<_Renderer> ctx = {&renderer, &cull_rect, jobs.Data};
+    pool.Run(slices, &RenderSliceJob<_Renderer>::Run, &ctx);
+
+    // stitch the slices back together, closing the holes left by culled primitives
+    ImDrawVert*  vtx_dst  = draw_list._VtxWritePtr;
+    ImDrawIdx*   idx_dst  = draw_list._IdxWritePtr;
+    unsigned int vtx_curr = draw_list._VtxCurrentIdx;
+    for (int i = 0; i < slices; ++i)
+    {
+        const RenderSlice& slice   = jobs[i];
+        const int          vtx_cnt = (int)(slice.VtxEnd - slice.VtxBegin);
+        const int          idx_cnt = (int)(slice.IdxEnd - slice.IdxBegin);
+        const ImDrawIdx    shift   = (ImDrawIdx)(slice.VtxCurrentIdx - vtx_curr);
+        if (vtx_dst != slice.VtxBegin)
+            memmove(vtx_dst, slice.VtxBegin, vtx_cnt * sizeof(ImDrawVert));
+        if (shift != 0)
+        {
+            for (int k = 0; k < idx_cnt; ++k)
+                idx_dst[k] = (ImDrawIdx)(slice.IdxBegin[k] - shift);
+        }
+        else if (idx_dst != slice.IdxBegin)
+        {
+            memmove(idx_dst, slice.IdxBegin, idx_cnt * sizeof(ImDrawIdx));
+        }
+        vtx_dst += vtx_cnt;
+        idx_dst += idx_cnt;
+        vtx_curr += vtx_cnt;
+    }
+    const unsigned int rendered = (unsigned int)(vtx_dst - draw_list._VtxWritePtr) / renderer.VtxConsumed;
+    draw_list._VtxWritePtr      = vtx_dst;
+    draw_list._IdxWritePtr      = idx_dst;
+    draw_list._VtxCurrentIdx    = vtx_curr;
+    return cnt - rendered;
+}
+
+#endif // IMPLOT_NO_THREADS
+
 /// Renders primitive shapes in bulk as efficiently as possible.
 template <class _Renderer>
 void RenderPrimitivesEx(const _Renderer& renderer, ImDrawList& draw_list, const ImRect& cull_rect)
@@ -1504,6 +1944,40 @@ void RenderPrimitivesEx(const _Renderer& renderer, ImDrawList& draw_list, const
     unsigned int prims_culled = 0;
     unsigned int idx          = 0;
     renderer.Init(draw_list);
+#ifndef IMPLOT_NO_THREADS
+    if (_Renderer::Parallel && prims >= IMPLOT_PARALLEL_MIN_PRIMS && GetWorkerPool().Size() > 1)
+    {
+        // large batches: every reservation is exact and culled primitives are returned right away,
+        // so each parallel pass starts from a clean write cursor
+        while (prims)
+        {
+            unsigned int cnt =
+                ImMin(prims, (MaxIdx<ImDrawIdx>::Value - draw_list._VtxCurrentIdx) / renderer.VtxConsumed);
+            if (cnt < ImMin(64u, prims))
+                cnt = ImMin(prims, MaxIdx<ImDrawIdx>::Value / renderer.VtxConsumed);
+            draw_list.PrimReserve(cnt * renderer.IdxConsumed, cnt * renderer.VtxConsumed);
+            if (cnt >= IMPLOT_PARALLEL_MIN_PRIMS)
+            {
+                prims_culled = RenderPrimitivesParallel(renderer, draw_list, cull_rect, idx, cnt);
+                idx += cnt;
+            }
+            else
+            {
+                prims_culled = 0;
+                renderer.Seek((int)idx);
+                for (unsigned int ie = idx + cnt; idx != ie; ++idx)
+                {
+                    if (!renderer.Render(draw_list, cull_rect, idx))
+                        prims_culled++;
+                }
+            }
+            if (prims_culled > 0)
+                draw_list.PrimUnreserve(prims_culled * renderer.IdxConsumed, prims_culled * renderer.VtxConsumed);
+            prims -= cnt;
+        }
+        return;
+    }
+#endif
     while (prims)
     {
         // find how many can be reserved up to end of current draw command's limit
@@ -1566,9 +2040,10 @@ void RenderPrimitives2(const _Getter1& getter1, const _Getter2& getter2, Args...
 
 template <class _Getter> struct RendererMarkersFill : RendererBase
 {
+    static const bool Parallel = GetterTraits<_Getter>::ThreadSafe;
     RendererMarkersFill(const _Getter& getter, const ImVec2* marker, int count, float size, ImU32 col)
-        : RendererBase(getter.Count, (count - 2) * 3, count), Getter(getter), Marker(marker), Count(count), Size(size),
-          Col(col)
+        : RendererBase(getter.Count, (count - 2) * 3, count), Getter(getter), Points(getter), Marker(marker),
+          Count(count), Size(size), Col(col)
     {
     }
     void Init(ImDrawList& draw_list) const
@@ -1577,7 +2052,7 @@ template <class _Getter> struct RendererMarkersFill : RendererBase
     }
     IMPLOT_INLINE bool Render(ImDrawList& draw_list, const ImRect& cull_rect, int prim) const
     {
-        ImVec2 p = this->Transformer(Getter(prim));
+        ImVec2 p = Points(this->Transformer, prim);
         if (p.x >= cull_rect.Min.x && p.y >= cull_rect.Min.y && p.x <= cull_rect.Max.x && p.y <= cull_rect.Max.y)
         {
             for (int i = 0; i < Count; i++)
@@ -1600,19 +2075,21 @@ template <class _Getter> struct RendererMarkersFill : RendererBase
         }
         return false;
     }
-    const _Getter& Getter;
-    const ImVec2*  Marker;
-    const int      Count;
-    const float    Size;
-    const ImU32    Col;
-    mutable ImVec2 UV;
+    const _Getter&          Getter;
+    TransformCache<_Getter> Points;
+    const ImVec2*           Marker;
+    const int               Count;
+    const float             Size;
+    const ImU32             Col;
+    mutable ImVec2          UV;
 };
 
 template <class _Getter> struct RendererMarkersLine : RendererBase
 {
+    static const bool Parallel = GetterTraits<_Getter>::ThreadSafe;
     RendererMarkersLine(const _Getter& getter, const ImVec2* marker, int count, float size, float weight, ImU32 col)
-        : RendererBase(getter.Count, count / 2 * 6, count / 2 * 4), Getter(getter), Marker(marker), Count(count),
-          HalfWeight(ImMax(1.0f, weight) * 0.5f), Size(size), Col(col)
+        : RendererBase(getter.Count, count / 2 * 6, count / 2 * 4), Getter(getter), Points(getter), Marker(marker),
+          Count(count), HalfWeight(ImMax(1.0f, weight) * 0.5f), Size(size), Col(col)
     {
     }
     void Init(ImDrawList& draw_list) const
@@ -1621,7 +2098,7 @@ template <class _Getter> struct RendererMarkersLine : RendererBase
     }
     IMPLOT_INLINE bool Render(ImDrawList& draw_list, const ImRect& cull_rect, int prim) const
     {
-        ImVec2 p = this->Transformer(Getter(prim));
+        ImVec2 p = Points(this->Transformer, prim);
         if (p.x >= cull_rect.Min.x && p.y >= cull_rect.Min.y && p.x <= cull_rect.Max.x && p.y <= cull_rect.Max.y)
         {
             for (int i = 0; i < Count; i = i + 2)
@@ -1634,14 +2111,15 @@ template <class _Getter> struct RendererMarkersLine : RendererBase
         }
         return false;
     }
-    const _Getter& Getter;
-    const ImVec2*  Marker;
-    const int      Count;
-    mutable float  HalfWeight;
-    const float    Size;
-    const ImU32    Col;
-    mutable ImVec2 UV0;
-    mutable ImVec2 UV1;
+    const _Getter&          Getter;
+    TransformCache<_Getter> Points;
+    const ImVec2*           Marker;
+    const int               Count;
+    mutable float           HalfWeight;
+    const float             Size;
+    const ImU32             Col;
+    mutable ImVec2          UV0;
+    mutable ImVec2          UV1;
 };
 
 static const ImVec2 MARKER_FILL_CIRCLE[10] = {ImVec2(1.0f, 0.0f),
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "LP/arrowFile.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class ArrowFileTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir temp;
+    LP::Telemetry     tel;
+    std::string       path = temp.path("lp_arrow_test.arrow");
+
+    template <typename T> static T get(const std::string& data, const size_t pos)
+    {
+        T value;
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        return value;
+    }
+};
+
+TEST_F(ArrowFileTest, Layout)
+{
+    // more than a batch, with a null
+    const size_t rows = ARROW_BATCH_ROWS + 100;
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        tel.push_frame({static_cast<double>(i), (i == 10) ? std::nan("") : -static_cast<double>(i)},
+                       1000.0 + i * 0.001,
+                       static_cast<double>(i));
+    }
+
+    std::atomic<size_t> progress = 0;
+    ASSERT_TRUE(LP::ArrowFile::save(path, tel, &progress));
+    EXPECT_EQ(progress, rows);
+
+    const std::string data = LP::test::read_file(path);
+
+    ASSERT_GT(data.size(), 16u);
+    EXPECT_EQ(data.substr(0, 8), std::string("ARROW1\0\0", 8));
+    EXPECT_EQ(data.substr(data.size() - 6), "ARROW1");
+
+    // walk the messages: schema, the batches and the end of stream marker
+    std::vector<uint8_t> headers;
+    size_t               pos = 8;
+
+    while (true)
+    {
+        ASSERT_LE(pos + 8, data.size());
+        ASSERT_EQ(get<uint32_t>(data, pos), 0xFFFFFFFF);
+
+        const uint32_t length = get<uint32_t>(data, pos + 4);
+
+        if (length == 0)
+            break;
+
+        // metadata and bodies keep the messages 8 bytes aligned
+        ASSERT_EQ(length % 8, 0u);
+
+        // Message table: header type in slot 1, body length in slot 3
+        const size_t root   = pos + 8;
+        const size_t table  = root + get<uint32_t>(data, root);
+        const size_t vtable = table - get<int32_t>(data, table);
+
+        const uint16_t type_field = get<uint16_t>(data, vtable + 4 + 2 * 1);
+        const uint16_t body_field = get<uint16_t>(data, vtable + 4 + 2 * 3);
+
+        ASSERT_NE(type_field, 0);
+        ASSERT_NE(body_field, 0);
+
+        headers.push_back(get<uint8_t>(data, table + type_field));
+
+        const auto body_length = get<int64_t>(data, table + body_field);
+        EXPECT_EQ(body_length % ARROW_ALIGNMENT, 0);
+
+        pos += 8 + length + body_length;
+    }
+
+    // a schema and two record batches
+    EXPECT_EQ(headers, (std::vector<uint8_t>{1, 3, 3}));
+
+    // the footer follows the end of stream marker, and its length precedes the trailing magic
+    const int32_t footer_length = get<int32_t>(data, data.size() - 10);
+
+    EXPECT_EQ(pos + 8 + footer_length + 10, data.size());
+}
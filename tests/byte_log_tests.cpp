@@ -0,0 +1,64 @@
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LP/byteLog.h"
+#include "LP/plotView.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class ByteLogTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir temp;
+    LP::Telemetry     tel;
+    std::string       path = temp.path("lp_byte_log_test.lpraw");
+};
+
+TEST_F(ByteLogTest, ReplayAtMaxSpeed)
+{
+    LP::ByteRecorder recorder;
+    ASSERT_TRUE(recorder.start(path));
+
+    // frames split across chunks, as read from a port
+    recorder.write({'1', ' ', '2', '\n', '3'}, 100.0);
+    recorder.write({' ', '4', '\n'}, 100.5);
+    recorder.write({}, 101.0);
+    recorder.stop();
+
+    // not recording anymore
+    recorder.write({'5', ' ', '6', '\n'}, 102.0);
+
+    LP::ByteReplay replay;
+    ASSERT_TRUE(replay.start(tel, path, 0));
+
+    while (replay.is_running())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    replay.poll();
+
+    auto data = *tel.get_data();
+
+    EXPECT_EQ(data[1].values, std::vector<double>({1, 3}));
+    EXPECT_EQ(data[2].values, std::vector<double>({2, 4}));
+    EXPECT_EQ(*tel.get_unix_timestamps(), std::vector<double>({100.0, 100.5}));
+    EXPECT_EQ(*tel.get_elapsed_timestamps(), std::vector<double>({0.0, 500.0}));
+    EXPECT_EQ(replay.get_progress(), 1.0f);
+}
+
+TEST_F(ByteLogTest, RejectsInvalidFiles)
+{
+    LP::ByteReplay replay;
+
+    EXPECT_FALSE(replay.start(tel, path, 0));
+
+    tel.push_frame({1}, 0, 0);
+
+    ASSERT_TRUE(LP::Telemetry::write_csv(path, tel.snapshot({0, 1, 0, 1}, {}, LP::ELAPSED)));
+    EXPECT_FALSE(replay.start(tel, path, 0));
+
+    // the telemetry is left untouched
+    EXPECT_EQ(tel.get_data()->at(1).values.size(), 1u);
+}
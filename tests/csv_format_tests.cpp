@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "LP/csvFormat.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+TEST(CsvFormatTest, ValueMatchesToString)
+{
+    for (const double value : {0.0, -0.0, 1.5, -2.125, 3.0000005, 123456789.987654, 1e-7, -1e20, 0.1 + 0.2})
+    {
+        std::string expected = std::to_string(value);
+        std::ranges::replace(expected, '.', ',');
+
+        std::string out;
+        LP::CsvFormatter::append_value(out, value);
+
+        EXPECT_EQ(out, expected);
+    }
+
+    std::string out;
+    LP::CsvFormatter::append_value(out, std::nan(""));
+
+    EXPECT_EQ(out, "");
+}
+
+TEST(CsvFormatTest, Times)
+{
+    LP::CsvFormatter formatter;
+    std::string      out;
+
+    formatter.append_time(out, 1499.6, LP::ELAPSED);
+    EXPECT_EQ(out, "1500");
+
+    // rows within the same second share the cached string
+    for (const double time : {1.7e9, 1.7e9 + 0.25, 1.7e9 + 1.5})
+    {
+        out.clear();
+        formatter.append_time(out, time, LP::DATETIME);
+
+        EXPECT_EQ(out, LP::Telemetry::format_datetime(time));
+    }
+}
+
+TEST(CsvFormatTest, Rows)
+{
+    LP::Snapshot snap;
+    snap.time_style = LP::ELAPSED;
+    snap.times      = {0, 20};
+    snap.names      = {"x", "y"};
+    snap.columns    = {{1, 2}, {std::nan(""), -0.5}};
+
+    LP::CsvFormatter formatter;
+    std::string      out;
+
+    LP::CsvFormatter::append_header(out, snap);
+    formatter.append_row(out, snap, 0);
+    formatter.append_row(out, snap, 1);
+
+    EXPECT_EQ(out, "times;x;y\n0;1,000000;\n20;2,000000;-0,500000\n");
+}
+
+TEST(CsvFormatTest, ParallelBlocksInOrder)
+{
+    LP::Snapshot snapshot;
+    snapshot.time_style = LP::DATETIME;
+    snapshot.columns.resize(64);
+
+    for (size_t c = 0; c < snapshot.columns.size(); c++)
+    {
+        snapshot.names.push_back("ch" + std::to_string(c));
+    }
+
+    // many blocks, with rows sharing seconds across block boundaries
+    for (int i = 0; i < 20000; i++)
+    {
+        snapshot.times.push_back(1700000000.0 + i * 0.01);
+
+        for (size_t c = 0; c < snapshot.columns.size(); c++)
+        {
+            snapshot.columns[c].push_back((i % 5 == 0) ? std::nan("") : i * 0.25 + static_cast<double>(c));
+        }
+    }
+
+    std::string      expected;
+    LP::CsvFormatter formatter;
+    LP::CsvFormatter::append_header(expected, snapshot);
+
+    for (size_t row = 0; row < snapshot.times.size(); row++)
+    {
+        formatter.append_row(expected, snapshot, row);
+    }
+
+    const LP::test::TempDir temp;
+    const std::string       path = temp.path("lp_csv_format_test.csv");
+
+    std::atomic<size_t> progress = 0;
+    ASSERT_TRUE(LP::Telemetry::write_csv(path, snapshot, &progress));
+    EXPECT_EQ(progress, snapshot.times.size());
+
+    EXPECT_EQ(LP::test::read_file(path), expected);
+}
+
+TEST(CsvFormatTest, CancelledWrite)
+{
+    LP::Snapshot snapshot;
+    snapshot.time_style = LP::ELAPSED;
+    snapshot.names      = {"a"};
+    snapshot.columns.resize(1);
+
+    for (int i = 0; i < 500000; i++)
+    {
+        snapshot.times.push_back(i);
+        snapshot.columns[0].push_back(i);
+    }
+
+    const LP::test::TempDir temp;
+    const std::string       path = temp.path("lp_csv_format_cancel.csv");
+
+    std::atomic<bool> cancel = true;
+    EXPECT_FALSE(LP::Telemetry::write_csv(path, snapshot, nullptr, &cancel));
+}
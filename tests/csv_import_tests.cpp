@@ -0,0 +1,168 @@
+#include <atomic>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "LP/csvImport.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class CsvImportTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir temp;
+    LP::Telemetry     tel;
+    std::string       path = temp.path("lp_csv_import_test.csv");
+
+    void write_file(const std::string& content)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+};
+
+TEST_F(CsvImportTest, DumpRoundTrip)
+{
+    // large enough to be split into several blocks
+    const size_t rows = 200000;
+
+    LP::Snapshot snapshot;
+    snapshot.time_style = LP::ELAPSED;
+    snapshot.names      = {"speed", "Data 1"};
+    snapshot.columns.resize(2);
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        snapshot.times.push_back(static_cast<double>(i));
+        snapshot.columns[0].push_back(i * 0.5);
+        snapshot.columns[1].push_back((i % 1000 == 7) ? std::nan("") : -static_cast<double>(i));
+    }
+
+    ASSERT_TRUE(LP::Telemetry::write_csv(path, snapshot));
+
+    std::atomic<size_t> progress = 0;
+    ASSERT_TRUE(LP::CsvImport::load(path, tel, &progress));
+
+    EXPECT_EQ(progress, std::filesystem::file_size(path));
+
+    auto data = *tel.get_data();
+
+    ASSERT_EQ(data.size(), 2u);
+    EXPECT_EQ(data[1].name, "speed");
+    EXPECT_EQ(data[2].name, "Data 1");
+
+    ASSERT_EQ(tel.get_elapsed_timestamps()->size(), rows);
+    ASSERT_EQ(data[1].values.size(), rows);
+    ASSERT_EQ(data[2].values.size(), rows);
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        ASSERT_EQ((*tel.get_elapsed_timestamps())[i], static_cast<double>(i));
+        ASSERT_EQ(data[1].values[i], i * 0.5);
+
+        if (i % 1000 == 7)
+            ASSERT_TRUE(std::isnan(data[2].values[i]));
+        else
+            ASSERT_EQ(data[2].values[i], -static_cast<double>(i));
+    }
+
+    // the last row is dated at the file's modification
+    const auto& times_unix = *tel.get_unix_timestamps();
+    EXPECT_NEAR(times_unix.back() - times_unix.front(), (rows - 1) / 1000.0, 1e-6);
+
+    EXPECT_EQ(data[1].extents.total().max, (rows - 1) * 0.5);
+    EXPECT_EQ(data[2].extents.total().min, -(rows - 1.0));
+}
+
+TEST_F(CsvImportTest, PlainCommaFile)
+{
+    // no header, CRLF endings, blank lines and missing fields
+    write_file("0,1.5,2\r\n\r\n10,,4e2\r\n20,-3\r\n");
+
+    ASSERT_TRUE(LP::CsvImport::load(path, tel));
+
+    auto data = *tel.get_data();
+
+    ASSERT_EQ(data.size(), 2u);
+    EXPECT_EQ(data[1].name, "Data 1");
+    EXPECT_EQ(*tel.get_elapsed_timestamps(), (std::vector<double>{0, 10, 20}));
+
+    ASSERT_EQ(data[1].values.size(), 3u);
+    EXPECT_EQ(data[1].values[0], 1.5);
+    EXPECT_TRUE(std::isnan(data[1].values[1]));
+    EXPECT_EQ(data[1].values[2], -3);
+
+    EXPECT_EQ(data[2].values[0], 2);
+    EXPECT_EQ(data[2].values[1], 400);
+    EXPECT_TRUE(std::isnan(data[2].values[2]));
+}
+
+TEST_F(CsvImportTest, Datetimes)
+{
+    write_file("times;a\n2024-01-02_03:04:05;1,25\n2024-01-02_03:04:07;2\n");
+
+    ASSERT_TRUE(LP::CsvImport::load(path, tel));
+
+    std::tm tm  = {};
+    tm.tm_year  = 124;
+    tm.tm_mon   = 0;
+    tm.tm_mday  = 2;
+    tm.tm_hour  = 3;
+    tm.tm_min   = 4;
+    tm.tm_sec   = 5;
+    tm.tm_isdst = -1;
+
+    const double first = static_cast<double>(std::mktime(&tm));
+
+    EXPECT_EQ(*tel.get_unix_timestamps(), (std::vector<double>{first, first + 2}));
+    EXPECT_EQ(*tel.get_elapsed_timestamps(), (std::vector<double>{0, 2000}));
+    EXPECT_EQ((*tel.get_data())[1].values, (std::vector<double>{1.25, 2}));
+}
+
+TEST_F(CsvImportTest, CancelKeepsData)
+{
+    tel.push_frame({1.0}, 1.0, 0.0);
+
+    write_file("times;a\n0;1\n");
+
+    const std::atomic<bool> cancel = true;
+
+    EXPECT_FALSE(LP::CsvImport::load(path, tel, nullptr, &cancel));
+    EXPECT_EQ(tel.get_elapsed_timestamps()->size(), 1u);
+}
+
+TEST_F(CsvImportTest, CompressedFiles)
+{
+    const std::string gz_path  = temp.path("lp_csv_import_test.csv.gz");
+    const std::string cut_path = temp.path("lp_csv_import_cut.csv.gz");
+
+    LP::Snapshot snapshot;
+    snapshot.time_style = LP::ELAPSED;
+    snapshot.names      = {"a"};
+    snapshot.columns.resize(1);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        snapshot.times.push_back(i);
+        snapshot.columns[0].push_back(i * 2);
+    }
+
+    ASSERT_TRUE(LP::Telemetry::write_csv(gz_path, snapshot));
+
+    // a recording still running has no gzip trailer yet
+    std::filesystem::copy_file(gz_path, cut_path, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(cut_path, std::filesystem::file_size(cut_path) - 8);
+
+    std::atomic<size_t> progress = 0;
+    ASSERT_TRUE(LP::CsvImport::load({gz_path, cut_path}, tel, &progress));
+
+    EXPECT_EQ(progress, std::filesystem::file_size(gz_path) + std::filesystem::file_size(cut_path));
+
+    ASSERT_EQ(tel.get_elapsed_timestamps()->size(), 2000u);
+    EXPECT_EQ((*tel.get_data())[1].name, "a");
+    EXPECT_EQ((*tel.get_data())[1].values[1999], 1998);
+}
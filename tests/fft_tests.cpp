@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <vector>
+
+#include "LP/fft.h"
+
+TEST(FFTTest, TransformMatchesDFT)
+{
+    std::vector<std::complex<double>> data;
+
+    for (int i = 0; i < 16; i++)
+    {
+        data.emplace_back(std::sin(i * 0.7) + 0.3 * i, std::cos(i * 1.3));
+    }
+
+    std::vector<std::complex<double>> expected(data.size());
+
+    for (size_t k = 0; k < data.size(); k++)
+    {
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            expected[k] += data[i] * std::polar(1.0, -2.0 * std::numbers::pi * k * i / data.size());
+        }
+    }
+
+    LP::FFT::transform(data);
+
+    for (size_t k = 0; k < data.size(); k++)
+    {
+        EXPECT_NEAR(data[k].real(), expected[k].real(), 1e-9);
+        EXPECT_NEAR(data[k].imag(), expected[k].imag(), 1e-9);
+    }
+}
+
+TEST(FFTTest, PowerPeaksAtSineBin)
+{
+    const size_t        n = 256;
+    std::vector<double> samples(n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        samples[i] = std::sin(2.0 * std::numbers::pi * 20 * i / n);
+    }
+
+    samples[3] = NAN;
+
+    std::vector<float>                power(n / 2);
+    std::vector<std::complex<double>> work;
+
+    LP::FFT::power_db(samples.data(), n, power.data(), work);
+
+    EXPECT_EQ(std::ranges::max_element(power) - power.begin(), 20);
+}
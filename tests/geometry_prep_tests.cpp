@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LP/geometryPrep.h"
+#include "LP/telemetry.h"
+
+TEST(GeometryPrepTest, DecimateKeepsColumnExtentsInTimeOrder)
+{
+    std::vector<double> times;
+    std::vector<double> values;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        times.push_back(i);
+        values.push_back((i % 7 == 3) ? 100.0 - i : std::sin(i));
+    }
+
+    LP::PreparedChannel out;
+    LP::GeometryPrep::decimate(times, values, 0, times.size(), 2.0, 1.0, 10.0, out);
+
+    ASSERT_EQ(out.xs.size(), out.ys.size());
+    EXPECT_LE(out.xs.size(), 200u);
+    EXPECT_TRUE(std::ranges::is_sorted(out.xs));
+
+    // the extremes of the whole range survive the decimation
+    EXPECT_DOUBLE_EQ(*std::ranges::max_element(out.ys), 97.0 * 2.0 + 1.0);
+    EXPECT_DOUBLE_EQ(*std::ranges::min_element(out.ys), -897.0 * 2.0 + 1.0);
+}
+
+TEST(GeometryPrepTest, DecimateKeepsGaps)
+{
+    const std::vector<double> times  = {0, 1, 2, 3, 4, 5};
+    const std::vector<double> values = {1, 2, NAN, NAN, 5, 6};
+
+    LP::PreparedChannel out;
+    LP::GeometryPrep::decimate(times, values, 0, times.size(), 1.0, 0.0, 2.0, out);
+
+    ASSERT_EQ(out.xs.size(), 5u);
+    EXPECT_DOUBLE_EQ(out.ys[1], 2.0);
+    EXPECT_TRUE(std::isnan(out.ys[2]));
+    EXPECT_DOUBLE_EQ(out.ys[3], 5.0);
+}
+
+TEST(GeometryPrepTest, PreparesVisibleRange)
+{
+    LP::Telemetry tel;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        tel.push_frame({static_cast<double>(i % 100)}, 0, i);
+    }
+
+    LP::GeometryPrep prep(tel);
+
+    LP::PrepRequest req;
+    req.x_min      = 4000;
+    req.x_max      = 6000;
+    req.width      = 100;
+    req.time_style = LP::ELAPSED;
+    req.channels   = {{1, 2.0, 1.0}, {7, 1.0, 0.0}};
+
+    prep.post(req, 10000);
+
+    // wait for the worker to publish the frame
+    bool ready = false;
+
+    for (int tries = 0; tries < 500 && !ready; tries++)
+    {
+        {
+            std::lock_guard lock(prep.get_front_mtx());
+            ready = prep.get_front().request == req;
+        }
+
+        if (!ready)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    ASSERT_TRUE(ready);
+
+    std::lock_guard          lock(prep.get_front_mtx());
+    const LP::PreparedFrame& frame = prep.get_front();
+
+    EXPECT_EQ(frame.samples, 10000u);
+
+    // the missing channel has no points
+    ASSERT_EQ(frame.channels.size(), 1u);
+
+    const LP::PreparedChannel& points = frame.channels.at(1);
+
+    // margin included, decimated to a min/max pair per column, plus the partial ones at the borders
+    EXPECT_LE(points.xs.front(), 3000);
+    EXPECT_GE(points.xs.back(), 7000);
+    EXPECT_LE(points.xs.size(), 2 * (200u + 2));
+    EXPECT_EQ(*std::ranges::max_element(points.ys), 99 * 2.0 + 1.0);
+    EXPECT_TRUE(std::ranges::is_sorted(points.xs));
+}
@@ -0,0 +1,104 @@
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <zlib.h>
+
+#include "LP/gzipWriter.h"
+#include "LP/plotView.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class GzipWriterTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir temp;
+    std::string       path  = temp.path("lp_gzip_test.csv.gz");
+    std::string       plain = temp.path("lp_gzip_test.csv");
+
+    static std::string read_gzip(const std::string& file_path)
+    {
+        gzFile      file = gzopen(file_path.c_str(), "rb");
+        std::string content;
+        char        buffer[4096];
+        int         n;
+
+        while ((n = gzread(file, buffer, sizeof(buffer))) > 0)
+        {
+            content.append(buffer, n);
+        }
+
+        gzclose(file);
+
+        return content;
+    }
+};
+
+TEST_F(GzipWriterTest, RoundTrip)
+{
+    LP::GzipWriter gzip;
+    ASSERT_TRUE(gzip.open(path));
+
+    std::string expected;
+
+    // more blocks than the queue holds
+    for (int i = 0; i < 4 * GZIP_QUEUE_BLOCKS; i++)
+    {
+        std::string block;
+
+        for (int row = 0; row < 10000; row++)
+        {
+            block += std::to_string(i * 10000 + row) + ";1,000000\n";
+        }
+
+        expected += block;
+        ASSERT_TRUE(gzip.write(block));
+        EXPECT_TRUE(block.empty());
+    }
+
+    ASSERT_TRUE(gzip.close());
+
+    EXPECT_EQ(read_gzip(path), expected);
+    EXPECT_LT(std::filesystem::file_size(path), expected.size() / 4);
+}
+
+TEST_F(GzipWriterTest, FlushedBeforeClose)
+{
+    LP::GzipWriter gzip;
+    ASSERT_TRUE(gzip.open(path));
+
+    std::string block = "times;a\n0;1\n";
+    ASSERT_TRUE(gzip.write(block, true));
+
+    // the worker takes a block once it's done with the previous one: once enough blocks pass through the queue, the
+    // first one is written
+    for (int i = 0; i < GZIP_QUEUE_BLOCKS + 1; i++)
+    {
+        std::string empty;
+        ASSERT_TRUE(gzip.write(empty, true));
+    }
+
+    // readable up to the last flush, without the gzip trailer
+    EXPECT_EQ(read_gzip(path), "times;a\n0;1\n");
+
+    ASSERT_TRUE(gzip.close());
+}
+
+TEST_F(GzipWriterTest, CompressedCsv)
+{
+    LP::Snapshot snapshot;
+    snapshot.time_style = LP::ELAPSED;
+    snapshot.names      = {"a"};
+    snapshot.columns.resize(1);
+
+    // several CSV_WRITE_BLOCK blocks
+    for (int i = 0; i < 300000; i++)
+    {
+        snapshot.times.push_back(i);
+        snapshot.columns[0].push_back(i % 7);
+    }
+
+    ASSERT_TRUE(LP::Telemetry::write_csv(path, snapshot));
+    ASSERT_TRUE(LP::Telemetry::write_csv(plain, snapshot));
+
+    EXPECT_EQ(read_gzip(path), LP::test::read_file(plain));
+}
@@ -0,0 +1,84 @@
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "LP/lpcap.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class LpCapTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir temp;
+    LP::Telemetry     tel;
+    std::string       path = temp.path("lp_lpcap_test.lpcap");
+};
+
+TEST_F(LpCapTest, RoundTrip)
+{
+    // more than a chunk, with a gap
+    const size_t rows = LPCAP_CHUNK_ROWS + 100;
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        tel.push_frame({static_cast<double>(i), (i == 10) ? std::nan("") : -static_cast<double>(i)},
+                       1000.0 + i * 0.001,
+                       static_cast<double>(i));
+    }
+
+    (*tel.get_data())[1].name  = "speed";
+    (*tel.get_data())[1].scale = 2.0;
+    std::strcpy(tel.frame_format.channel_sep, ",");
+
+    ASSERT_TRUE(LP::LpCapFile::save(path, tel));
+
+    LP::LpCapFile file;
+    ASSERT_TRUE(file.open(path));
+
+    ASSERT_EQ(file.get_chunks().size(), 2u);
+    EXPECT_EQ(file.get_rows(), rows);
+    EXPECT_STREQ(file.get_frame_format().channel_sep, ",");
+
+    const LP::Limits overview = file.get_overview(LP::ELAPSED);
+
+    EXPECT_EQ(overview.x_min, 0);
+    EXPECT_EQ(overview.x_max, rows - 1.0);
+    EXPECT_EQ(overview.y_min, -(rows - 1.0));
+    EXPECT_EQ(overview.y_max, 2 * (rows - 1.0));
+
+    LP::Telemetry loaded;
+
+    for (size_t chunk = 0; chunk < file.get_chunks().size(); chunk++)
+        file.load_chunk(chunk, loaded);
+
+    auto data = *loaded.get_data();
+
+    EXPECT_EQ(data[1].name, "speed");
+    EXPECT_EQ(data[1].scale, 2.0);
+    EXPECT_EQ(data[1].values, (*tel.get_data())[1].values);
+    ASSERT_EQ(data[2].values.size(), rows);
+    EXPECT_TRUE(std::isnan(data[2].values[10]));
+    EXPECT_EQ(data[2].values[rows - 1], -(rows - 1.0));
+    EXPECT_EQ(*loaded.get_unix_timestamps(), *tel.get_unix_timestamps());
+    EXPECT_EQ(*loaded.get_elapsed_timestamps(), *tel.get_elapsed_timestamps());
+    EXPECT_EQ(data[1].extents.total().max, rows - 1.0);
+}
+
+TEST_F(LpCapTest, RejectsInvalidFiles)
+{
+    std::ofstream(path) << "times;Data 1\n0;1,000000\n";
+
+    LP::LpCapFile file;
+    EXPECT_FALSE(file.open(path));
+
+    tel.push_frame({1, 2}, 0, 0);
+    ASSERT_TRUE(LP::LpCapFile::save(path, tel));
+
+    // truncated
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(file.open(path));
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "LP/rangeIndex.h"
+
+class RangeIndexTest : public ::testing::Test
+{
+  protected:
+    LP::RangeIndex      index;
+    std::vector<double> values;
+
+    void push(double value)
+    {
+        values.push_back(value);
+        index.push(value);
+    }
+
+    LP::Extents scan(size_t first, size_t last) const
+    {
+        LP::Extents result;
+        for (size_t i = first; i < last; i++)
+        {
+            result.extend(values[i]);
+        }
+        return result;
+    }
+};
+
+TEST_F(RangeIndexTest, Query_MatchesScan)
+{
+    for (int i = 0; i < 5000; i++)
+    {
+        push(std::sin(i * 0.37) * i);
+    }
+
+    for (size_t first = 0; first < values.size(); first += 97)
+    {
+        for (size_t last = first; last <= values.size(); last += 131)
+        {
+            LP::Extents expected = scan(first, last);
+            LP::Extents result   = index.query(values, first, last);
+
+            EXPECT_EQ(result.valid(), expected.valid());
+            if (expected.valid())
+            {
+                EXPECT_EQ(result.min, expected.min);
+                EXPECT_EQ(result.max, expected.max);
+            }
+        }
+    }
+
+    EXPECT_EQ(index.total().min, scan(0, values.size()).min);
+    EXPECT_EQ(index.total().max, scan(0, values.size()).max);
+}
+
+TEST_F(RangeIndexTest, Query_IgnoresNaN)
+{
+    push(NAN);
+    push(3);
+    push(NAN);
+    push(-2);
+
+    LP::Extents result = index.query(values, 0, values.size());
+
+    EXPECT_EQ(result.min, -2);
+    EXPECT_EQ(result.max, 3);
+    EXPECT_FALSE(index.query(values, 2, 3).valid());
+}
+
+TEST_F(RangeIndexTest, Level_SummarisesWholeSeries)
+{
+    for (int i = 0; i < 100000; i++)
+    {
+        push(i % 1000);
+    }
+
+    size_t      block_size = 0;
+    const auto& level      = index.level(64, block_size);
+
+    ASSERT_FALSE(level.empty());
+    EXPECT_LE(level.size(), 64u);
+    EXPECT_EQ(level.size(), (values.size() + block_size - 1) / block_size);
+
+    for (size_t k = 0; k < level.size(); k++)
+    {
+        const LP::Extents expected = scan(k * block_size, std::min((k + 1) * block_size, values.size()));
+
+        EXPECT_EQ(level[k].min, expected.min);
+        EXPECT_EQ(level[k].max, expected.max);
+    }
+}
@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LP/csvImport.h"
+#include "LP/recordIndex.h"
+#include "LP/recorder.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class RecordIndexTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir            temp;
+    const std::filesystem::path& dir  = temp.get_dir();
+    std::string                  base = temp.path("capture.csv");
+};
+
+TEST_F(RecordIndexTest, Paths)
+{
+    EXPECT_EQ(LP::RecordIndex::index_path(base), (dir / "capture.lpidx").string());
+    EXPECT_EQ(LP::RecordIndex::segment_path(base, 1), (dir / "capture_0001.csv").string());
+    EXPECT_EQ(LP::RecordIndex::segment_path((dir / "capture.csv.gz").string(), 12),
+              (dir / "capture_0012.csv.gz").string());
+    EXPECT_EQ(LP::RecordIndex::index_path((dir / "capture.csv.gz").string()), (dir / "capture.lpidx").string());
+}
+
+TEST_F(RecordIndexTest, SaveLoadFind)
+{
+    LP::RecordIndex index;
+    index.set_time_style(LP::DATETIME);
+    index.get_segments() = {{"a;1.csv", 0, 9.5, 10}, {"b.csv", 10, 19.5, 10}, {"c.csv", NAN, NAN, 0}};
+
+    const std::string path = LP::RecordIndex::index_path(base);
+    ASSERT_TRUE(index.save(path));
+
+    LP::RecordIndex loaded;
+    ASSERT_TRUE(loaded.load(path));
+
+    EXPECT_EQ(loaded.get_time_style(), LP::DATETIME);
+    ASSERT_EQ(loaded.get_segments().size(), 3u);
+    EXPECT_EQ(loaded.get_segments()[0].file, "a;1.csv");
+    EXPECT_EQ(loaded.get_segments()[1].last, 19.5);
+    EXPECT_TRUE(std::isnan(loaded.get_segments()[2].first));
+    EXPECT_EQ(loaded.get_path(1), (dir / "b.csv").string());
+
+    EXPECT_EQ(loaded.find(-5), 0u);
+    EXPECT_EQ(loaded.find(12), 1u);
+    EXPECT_EQ(loaded.find(50), 3u);
+
+    EXPECT_EQ(loaded.find_range(5, 8), (std::pair<size_t, size_t>{0, 1}));
+    EXPECT_EQ(loaded.find_range(5, 15), (std::pair<size_t, size_t>{0, 3}));
+    EXPECT_EQ(loaded.find_range(15, 100), (std::pair<size_t, size_t>{1, 3}));
+
+    EXPECT_FALSE(loaded.load((dir / "missing.lpidx").string()));
+}
+
+TEST_F(RecordIndexTest, RecorderRotates)
+{
+    LP::Telemetry tel;
+    LP::Recorder  recorder;
+
+    // every batch goes to a new file, and only the last two are kept
+    ASSERT_TRUE(recorder.start(tel, base, LP::ELAPSED, -1, {1, 0, 2}));
+
+    for (int i = 0; i < 4; i++)
+    {
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+
+            tel.push_frame({static_cast<double>(i)}, 0, i * 10.0);
+            recorder.commit(tel);
+        }
+
+        // one batch per write
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * RECORDER_WRITE_INTERVAL_MS));
+    }
+
+    recorder.stop();
+
+    LP::RecordIndex index;
+    ASSERT_TRUE(index.load(LP::RecordIndex::index_path(base)));
+
+    const auto& segments = index.get_segments();
+    ASSERT_EQ(segments.size(), 2u);
+    EXPECT_EQ(segments[0].file, "capture_0003.csv");
+    EXPECT_EQ(segments[0].first, 20);
+    EXPECT_EQ(segments[1].last, 30);
+    EXPECT_EQ(segments[1].rows, 1u);
+
+    EXPECT_FALSE(std::filesystem::exists(LP::RecordIndex::segment_path(base, 1)));
+    EXPECT_FALSE(std::filesystem::exists(LP::RecordIndex::segment_path(base, 2)));
+
+    // the kept files load back as one capture
+    LP::Telemetry loaded;
+    ASSERT_TRUE(LP::CsvImport::load({index.get_path(0), index.get_path(1)}, loaded));
+
+    EXPECT_EQ(*loaded.get_elapsed_timestamps(), (std::vector<double>{20, 30}));
+    EXPECT_EQ((*loaded.get_data())[1].values, (std::vector<double>{2, 3}));
+}
+
+TEST_F(RecordIndexTest, IndexCurrentWhileRecording)
+{
+    LP::Telemetry tel;
+    LP::Recorder  recorder;
+
+    ASSERT_TRUE(recorder.start(tel, base, LP::ELAPSED, -1, {1 << 20, 0, 2}));
+
+    for (int i = 0; i < 3; i++)
+    {
+        {
+            std::lock_guard lock(tel.get_data_mtx());
+
+            tel.push_frame({static_cast<double>(i)}, 0, i * 10.0);
+            recorder.commit(tel);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * RECORDER_WRITE_INTERVAL_MS));
+    }
+
+    // read as after a crash, without stopping the recording
+    LP::RecordIndex index;
+    const bool      loaded = index.load(LP::RecordIndex::index_path(base));
+
+    recorder.stop();
+
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(index.get_segments().size(), 1u);
+    EXPECT_EQ(index.get_segments()[0].rows, 3u);
+    EXPECT_EQ(index.get_segments()[0].last, 20);
+
+    // the newest rows are found in the set
+    EXPECT_EQ(index.find(15), 0u);
+    EXPECT_EQ(index.find_range(15, 20), (std::pair<size_t, size_t>{0, 1}));
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+
+#include "LP/recorder.h"
+#include "LP/telemetry.h"
+#include "test_files.h"
+
+class RecorderTest : public ::testing::Test
+{
+  protected:
+    LP::test::TempDir temp;
+    LP::Telemetry     tel;
+    LP::Recorder      recorder;
+    std::string       path = temp.path("lp_recorder_test.csv");
+
+    void push_and_commit(double value, double elapsed)
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+
+        tel.push_frame({value, -value}, 0, elapsed);
+        recorder.commit(tel);
+    }
+};
+
+TEST_F(RecorderTest, RecordsCommittedRows)
+{
+    // rows received before the start aren't recorded
+    push_and_commit(1, 0);
+
+    ASSERT_TRUE(recorder.start(tel, path, LP::ELAPSED, 0));
+    EXPECT_TRUE(recorder.is_active());
+
+    push_and_commit(2, 10);
+    push_and_commit(3.5, 20);
+
+    recorder.stop();
+    EXPECT_FALSE(recorder.is_active());
+
+    EXPECT_EQ(LP::test::read_file(path), "times;Data 1;Data 2\n10;2,000000;-2,000000\n20;3,500000;-3,500000\n");
+}
+
+TEST_F(RecorderTest, ContinuesAfterClear)
+{
+    ASSERT_TRUE(recorder.start(tel, path, LP::ELAPSED, -1));
+
+    push_and_commit(1, 0);
+    push_and_commit(2, 10);
+
+    {
+        std::lock_guard lock(tel.get_data_mtx());
+        tel.clear_values();
+    }
+
+    push_and_commit(3, 0);
+
+    recorder.stop();
+
+    EXPECT_EQ(LP::test::read_file(path),
+              "times;Data 1;Data 2\n0;1,000000;-1,000000\n10;2,000000;-2,000000\n0;3,000000;-3,000000\n");
+}
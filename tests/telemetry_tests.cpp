@@ -1,9 +1,13 @@
+#include <cmath>
 #include <cstring>
 #include <gtest/gtest.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "LP/plotView.h"
 #include "LP/telemetry.h"
+#include "test_files.h"
 
 class TelemetryTest : public ::testing::Test
 {
@@ -74,3 +78,123 @@ TEST_F(TelemetryTest, ParseFrame_Named)
     EXPECT_EQ(data[2].values, expected_ch2);
     EXPECT_EQ(data[3].values, expected_ch3);
 }
+
+TEST_F(TelemetryTest, ParseFrame_ValueRuns)
+{
+    std::string frame_stream = "5\n5\n7\n7\nx\nx\n5\n";
+
+    tel.parse_frame(frame_stream);
+
+    auto data = *tel.get_data();
+
+    // only built on demand, for bitfield channels
+    EXPECT_TRUE(data[1].runs.empty());
+
+    LP::Telemetry::extend_runs(data[1]);
+
+    ASSERT_EQ(data[1].runs.size(), 3u);
+    EXPECT_EQ(data[1].runs[0].first, 0u);
+    EXPECT_EQ(data[1].runs[0].value, 5);
+    EXPECT_EQ(data[1].runs[1].first, 2u);
+    EXPECT_EQ(data[1].runs[1].value, 7);
+    EXPECT_EQ(data[1].runs[2].first, 4u);
+    EXPECT_EQ(data[1].runs[2].value, 5);
+
+    // extended with the new values only
+    data[1].values.insert(data[1].values.end(), {5, 9});
+    LP::Telemetry::extend_runs(data[1]);
+
+    ASSERT_EQ(data[1].runs.size(), 4u);
+    EXPECT_EQ(data[1].runs[3].first, 6u);
+    EXPECT_EQ(data[1].runs[3].value, 9);
+    EXPECT_EQ(data[1].runs_end, 7u);
+
+    // rebuilt with the range index, since the channel keeps them
+    data[1].values = {1, 1, 2};
+    LP::Telemetry::index_channel(data[1]);
+
+    ASSERT_EQ(data[1].runs.size(), 2u);
+    EXPECT_EQ(data[1].runs[1].first, 2u);
+}
+
+TEST_F(TelemetryTest, UpdateRuns_BitfieldsOnly)
+{
+    // the pass the plot runs every frame, before drawing the single plot or the strip chart lanes
+    std::unordered_map<int, LP::ChannelStyle> styles;
+    styles[1].bits = 8;
+    styles[2].bits = 0;
+
+    tel.parse_frame("1 5\n1 6\n");
+    LP::Telemetry::update_runs(*tel.get_data(), styles);
+
+    EXPECT_EQ((*tel.get_data())[1].runs.size(), 1u);
+    EXPECT_TRUE((*tel.get_data())[2].runs.empty());
+
+    // new samples are picked up on the next frame, so the lane shows the latest transitions
+    tel.parse_frame("3 7\n");
+    LP::Telemetry::update_runs(*tel.get_data(), styles);
+
+    ASSERT_EQ((*tel.get_data())[1].runs.size(), 2u);
+    EXPECT_EQ((*tel.get_data())[1].runs[1].first, 2u);
+    EXPECT_EQ((*tel.get_data())[1].runs[1].value, 3);
+
+    // back to a plotted value, the runs are released
+    styles[1].bits = 0;
+    LP::Telemetry::update_runs(*tel.get_data(), styles);
+
+    EXPECT_TRUE((*tel.get_data())[1].runs.empty());
+    EXPECT_EQ((*tel.get_data())[1].runs_end, 0u);
+}
+
+TEST_F(TelemetryTest, PushFrame)
+{
+    tel.push_frame({1.5, 2.5}, 100.0, 0.0);
+    tel.push_frame({3.5, 4.5}, 100.5, 500.0);
+
+    auto data = *tel.get_data();
+
+    EXPECT_EQ(data[1].name, "Data 1");
+    EXPECT_EQ(data[1].values, std::vector<double>({1.5, 3.5}));
+    EXPECT_EQ(data[2].values, std::vector<double>({2.5, 4.5}));
+    EXPECT_EQ(*tel.get_unix_timestamps(), std::vector<double>({100.0, 100.5}));
+    EXPECT_EQ(*tel.get_elapsed_timestamps(), std::vector<double>({0.0, 500.0}));
+}
+
+// === EXPORT ===
+TEST_F(TelemetryTest, Snapshot_Window)
+{
+    for (int i = 0; i < 5; i++)
+        tel.push_frame({static_cast<double>(i), 10.0 * i}, 100.0 + i, 1000.0 * i);
+
+    std::unordered_map<int, LP::ChannelStyle> styles;
+    styles[1].show = true;
+    styles[2].show = false;
+
+    // rows 1 to 3, values above 2 are left out
+    const LP::Snapshot snap = tel.snapshot({1000, 3000, 0, 2}, styles, LP::ELAPSED);
+
+    EXPECT_EQ(snap.times, std::vector<double>({1000, 2000, 3000}));
+    ASSERT_EQ(snap.names, std::vector<std::string>({"Data 1"}));
+    ASSERT_EQ(snap.columns.size(), 1u);
+    EXPECT_EQ(snap.columns[0][0], 1);
+    EXPECT_EQ(snap.columns[0][1], 2);
+    EXPECT_TRUE(std::isnan(snap.columns[0][2]));
+}
+
+TEST_F(TelemetryTest, WriteCsv)
+{
+    LP::Snapshot snap;
+    snap.time_style = LP::ELAPSED;
+    snap.times      = {0, 1500};
+    snap.names      = {"a", "b"};
+    snap.columns    = {{1.25, std::nan("")}, {-2, 3}};
+
+    const LP::test::TempDir temp;
+    const std::string       path = temp.path("lp_write_csv_test.csv");
+
+    std::atomic<size_t> progress = 0;
+    ASSERT_TRUE(LP::Telemetry::write_csv(path, snap, &progress));
+    EXPECT_EQ(progress, 2u);
+
+    EXPECT_EQ(LP::test::read_file(path), "times;a;b\n0;1,250000;-2,000000\n1500;;3,000000\n");
+}
@@ -0,0 +1,53 @@
+#ifndef __TEST_FILES_H__
+#define __TEST_FILES_H__
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+namespace LP::test {
+    // Directory of the temporary files of the running test, removed with it. Every test gets its own, since ctest runs
+    // the tests of a fixture as separate processes, possibly at the same time.
+    class TempDir {
+        private:
+            std::filesystem::path dir;
+        public:
+            TempDir()
+            {
+                const ::testing::TestInfo* info = ::testing::UnitTest::GetInstance()->current_test_info();
+
+                dir = std::filesystem::temp_directory_path() / "lp_test_files" /
+                      (std::string(info->test_suite_name()) + "." + info->name());
+
+                std::error_code ec;
+                std::filesystem::remove_all(dir, ec);
+                std::filesystem::create_directories(dir);
+            }
+
+            ~TempDir()
+            {
+                std::error_code ec;
+                std::filesystem::remove_all(dir, ec);
+            }
+
+            TempDir(const TempDir&)            = delete;
+            TempDir& operator=(const TempDir&) = delete;
+
+            std::string path(const std::string& name) const { return (dir / name).string(); }
+
+            const std::filesystem::path& get_dir() const { return dir; }
+    };
+
+    // whole content of a file, read as binary
+    inline std::string read_file(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+}
+
+#endif